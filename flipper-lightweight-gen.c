@@ -1,210 +1,3357 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <gui/gui.h>
 #include <notification/notification_messages.h>
+#include <storage/storage.h>
 #include <dolphin/dolphin.h>
 #include <stdlib.h>
 #include <math.h>
 
+// Constant tables, generated by tools/gen_luts.py
+#include "lut_tables.h"
+// Gradient patterns, shared with tools/gradient_parity.c
+#include "gradient.h"
+
+#define TAG "GenArt"
+
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 
-typedef struct {
-    uint8_t pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
-    uint32_t seed;
-    uint8_t mode;
-    uint8_t gradient_type;
-    float frequency;
-    float noise_scale;
-    bool invert;
-    uint32_t frame_count;
-} GenerativeState;
+// Packed 1bpp framebuffer: 32 pixels per word, LSB = leftmost pixel.
+// On the little-endian Cortex-M4 this is byte-for-byte XBM layout.
+#define FB_WORDS (SCREEN_WIDTH / 32)
+
+typedef enum {
+    GenModeGradient,
+    GenModeFlowField,
+    GenModeBoids,
+    GenModeSand,
+    GenModeWorley,
+    GenModeDla,
+    GenModeWireframe,
+    GenModeSdf,
+    GenModeTiles,
+    GenModeLsystem,
+    GenModeSplit,
+    GenModeCycle,
+    GenModeImage,
+    GenModeCalibrate,
+    GenModeCount,
+} GenMode;
+
+// Quality tiers for dithered patterns, stepped automatically under load
+typedef enum {
+    QualityFloydSteinberg, // full resolution, error diffusion
+    QualityOrdered, // full resolution, 8x8 Bayer thresholds
+    QualityHalfRes, // 64x32 generation upscaled 2x, Bayer thresholds
+    QualityTierCount,
+} QualityTier;
+
+// Optional filter between generation and dithering. Separable running-sum
+// passes streamed down the rows: only a few rows are buffered at a time.
+typedef enum {
+    FilterNone,
+    FilterBlur, // box, radius 2
+    FilterGaussian, // two box passes: a tent, close to a Gaussian
+    FilterSharpen, // unsharp mask against a radius 1 box
+    FilterEdges, // Sobel magnitude
+    FilterCount,
+} FilterKind;
+
+#define FILTER_RADIUS_MAX 2
+#define FILTER_WINDOW_MAX (2 * FILTER_RADIUS_MAX + 1)
+
+// Post-dither effects on the packed framebuffer, 3x3 neighbourhoods built
+// from word shifts, ANDs and ORs of neighbouring rows
+typedef enum {
+    MorphNone,
+    MorphDilate,
+    MorphErode,
+    MorphOpen, // erode then dilate: drops isolated dots
+    MorphClose, // dilate then erode: fills pinholes
+    MorphOutline, // ink minus its erosion
+    MorphEdgeInvert, // flip pixels where dilation and erosion differ
+    MorphCount,
+} MorphKind;
+
+// Half-resolution field evaluation, bilinearly upsampled 2x before dithering
+#define HALF_W (SCREEN_WIDTH / 2)
+#define HALF_H (SCREEN_HEIGHT / 2)
+
+#define FRAME_BUDGET_US 33333
+// Render on demand: a tick is skipped while the last frame is undrawn,
+// unless it has waited this many ticks (GUI covered or stalled)
+#define FRAME_DEADLINE_TICKS 4
+#define FRAME_STATS_INTERVAL 300 // produced frames between stats logs
+#define PERF_LOG_INTERVAL 30 // frames between timing logs
+#define QUALITY_DOWN_US (FRAME_BUDGET_US * 3 / 4) // step down above this...
+#define QUALITY_DOWN_FRAMES 3 // ...for this many frames in a row
+#define QUALITY_UP_US (FRAME_BUDGET_US / 4) // step up below this...
+#define QUALITY_UP_FRAMES 60 // ...for two seconds
+
+// Flow field: particles advected by a coarse noise-driven vector grid
+#define FLOW_PARTICLES 2048
+#define FLOW_CELL_SHIFT 2 // 4x4 pixel cells
+#define FLOW_GRID_W (SCREEN_WIDTH >> FLOW_CELL_SHIFT)
+#define FLOW_GRID_H (SCREEN_HEIGHT >> FLOW_CELL_SHIFT)
+#define FLOW_RESPAWN_SHIFT 8 // 1/256 of the pool respawns each frame
+
+typedef struct {
+    // Structure-of-arrays pool, 8.8 fixed point (wraps at 128x64 via masks)
+    uint16_t x[FLOW_PARTICLES];
+    uint16_t y[FLOW_PARTICLES];
+    int16_t vx[FLOW_PARTICLES];
+    int16_t vy[FLOW_PARTICLES];
+    int8_t field_x[FLOW_GRID_H][FLOW_GRID_W];
+    int8_t field_y[FLOW_GRID_H][FLOW_GRID_W];
+    uint8_t fade; // random masks ANDed per frame; more = slower fade
+    uint32_t rng;
+} FlowFieldState;
+
+// Boids: neighbour queries go through a uniform grid rebuilt each frame
+#define BOIDS_MAX 1024
+#define BOIDS_MIN 64
+#define BOIDS_CELL_SHIFT 3 // 8x8 pixel cells, equal to the view radius
+#define BOIDS_GRID_W (SCREEN_WIDTH >> BOIDS_CELL_SHIFT)
+#define BOIDS_GRID_H (SCREEN_HEIGHT >> BOIDS_CELL_SHIFT)
+#define BOIDS_CELLS (BOIDS_GRID_W * BOIDS_GRID_H)
+
+typedef struct {
+    uint16_t x[BOIDS_MAX]; // 8.8 fixed point, toroidal
+    uint16_t y[BOIDS_MAX];
+    int16_t vx[BOIDS_MAX];
+    int16_t vy[BOIDS_MAX];
+    int16_t next_vx[BOIDS_MAX];
+    int16_t next_vy[BOIDS_MAX];
+    uint8_t cell[BOIDS_MAX];
+    // Counting sort output: boids of cell c are order[cell_start[c]..cell_start[c + 1])
+    uint16_t cell_start[BOIDS_CELLS + 1];
+    uint16_t order[BOIDS_MAX];
+    uint16_t count;
+    uint32_t rng;
+} BoidsState;
+
+// Block RNG: four interleaved xorshift32 lanes refilled a block at a time
+#define BLOCK_RNG_WORDS 64
+
+typedef struct {
+    uint32_t words[BLOCK_RNG_WORDS];
+    uint32_t lanes[4];
+    uint32_t pos;
+} BlockRng;
+
+// Falling sand: grains are the framebuffer bits themselves
+#define SAND_STEPS_DEFAULT 4
+#define SAND_STEPS_MAX 8
+#define SAND_EMITTERS 3
+#define SAND_DRAIN_ROW 12 // start draining when the pile reaches this row
+
+typedef struct {
+    BlockRng rng;
+    uint8_t steps_per_frame;
+    bool draining;
+} SandState;
+
+// Worley noise: one drifting site per 16x16 cell, 3x3 cell neighbourhood
+#define WORLEY_CELL_SHIFT 4
+#define WORLEY_CELL (1 << WORLEY_CELL_SHIFT)
+#define WORLEY_GRID_W (SCREEN_WIDTH >> WORLEY_CELL_SHIFT)
+#define WORLEY_GRID_H (SCREEN_HEIGHT >> WORLEY_CELL_SHIFT)
+#define WORLEY_CANDIDATES 9
+
+typedef enum {
+    WorleyF1, // distance to nearest site: soft cells
+    WorleyEdges, // F2 - F1: bright cell borders
+    WorleyVariantCount,
+} WorleyVariant;
+
+typedef struct {
+    uint8_t site_x[WORLEY_GRID_H][WORLEY_GRID_W];
+    uint8_t site_y[WORLEY_GRID_H][WORLEY_GRID_W];
+    uint8_t phase[WORLEY_GRID_H][WORLEY_GRID_W];
+    uint8_t variant;
+} WorleyState;
+
+// Diffusion-limited aggregation: the framebuffer is the occupancy bitmap
+#define DLA_WALKERS 128
+#define DLA_CELL_SHIFT 3 // coarse distance map cells, 8x8 pixels
+#define DLA_GRID_W (SCREEN_WIDTH >> DLA_CELL_SHIFT)
+#define DLA_GRID_H (SCREEN_HEIGHT >> DLA_CELL_SHIFT)
+#define DLA_BUDGET_US 8000 // per tick, leaves the rest of the 33 ms to the GUI
+#define DLA_HOLD_FRAMES 90 // pause on a finished cluster before regrowing
+
+typedef struct {
+    int16_t x[DLA_WALKERS];
+    int16_t y[DLA_WALKERS];
+    // Chebyshev distance in cells to the nearest occupied cell
+    uint8_t dist[DLA_GRID_H][DLA_GRID_W];
+    BlockRng rng;
+    uint32_t stuck;
+    uint32_t steps; // walker steps taken last tick
+    uint16_t hold;
+} DlaState;
+
+// Wireframe: fixed-point rotating solid over a 3D starfield
+#define WIRE_STARS 96
+#define WIRE_CAMERA_Z 128 // solid centre distance
+#define WIRE_FOCAL 48
+
+typedef enum {
+    WireSolidCube,
+    WireSolidOctahedron,
+    WireSolidCount,
+} WireSolid;
+
+typedef struct {
+    int16_t star_x[WIRE_STARS]; // -1024..1023, projected by 1/z
+    int16_t star_y[WIRE_STARS];
+    uint8_t star_z[WIRE_STARS];
+    uint16_t angle_x; // 8.8, integer part indexes the sine table
+    uint16_t angle_y;
+    uint8_t solid;
+    uint32_t rng;
+} WireframeState;
+
+// SDF raymarcher: 64x32 in two progressive passes, upscaled 2x and dithered
+#define SDF_W 64
+#define SDF_H 32
+#define SDF_MAX_STEPS 24
+#define SDF_FAR (12 * 256) // 8.8 fixed point world units
+#define SDF_BUDGET_US 16000 // per tick, out of the 33 ms frame
+
+typedef enum {
+    SdfSceneSphere,
+    SdfSceneTorus,
+    SdfSceneTwist,
+    SdfSceneCount,
+} SdfScene;
+
+typedef struct {
+    uint8_t shade[SDF_H][SDF_W]; // brightness, 0 = black
+    uint16_t cursor; // next pixel of the current pass
+    uint8_t pass; // 0: every other pixel (32x16), 1: the rest
+    uint8_t scene;
+    uint16_t angle; // 8.8, advanced once per completed image
+    uint32_t rays; // traced this tick
+    uint32_t steps; // march steps this tick
+    uint32_t images; // completed 64x32 images
+} SdfState;
+
+// Tile patterns: a seeded orientation bit per cell picks one of two
+// pre-rendered tiles, which are copied into the framebuffer byte by byte
+#define TILE_ROWS (SCREEN_HEIGHT / 8)
+#define FB_ROW_BYTES (SCREEN_WIDTH / 8)
+
+typedef enum {
+    TileFamilyTruchet, // quarter arcs, 8x8
+    TileFamilyTruchetLarge, // quarter arcs, 16x16
+    TileFamily10Print, // diagonals
+    TileFamilyMaze, // wall on top or left: a binary-tree maze
+    TileFamilyCount,
+} TileFamily;
+
+typedef struct {
+    uint16_t orient[TILE_ROWS]; // bit tx: which of the two tiles
+    uint8_t family;
+    uint32_t flips; // tiles flipped last frame
+    uint32_t rng;
+} TileState;
+
+// L-systems: rules are expanded lazily by a depth-bounded stack into a small
+// command buffer, so no generation is ever materialized
+#define LSYS_MAX_DEPTH 10
+#define LSYS_CHUNK 32 // commands expanded per refill
+#define LSYS_TURTLE_STACK 32 // [ ] nesting
+#define LSYS_BUDGET_US 6000 // per tick, out of the 33 ms frame
+#define LSYS_HOLD_FRAMES 60 // pause on a finished drawing
+#define LSYS_MIN_DEPTH 2 // shallower drawings are just a few strokes
+
+typedef struct {
+    char symbol;
+    const char* replace;
+} LsysRule;
+
+typedef struct {
+    const char* name;
+    const char* axiom;
+    LsysRule rules[2];
+    const char* draw; // symbols that step forward drawing a line
+    uint16_t angle; // 8.8 sine table steps, 64 steps per turn
+    uint16_t heading; // start direction
+    uint8_t max_depth;
+} LsysSystem;
+
+typedef struct {
+    const char* next;
+    uint8_t depth;
+} LsysFrame;
+
+typedef struct {
+    int32_t x; // 16.16
+    int32_t y;
+    uint16_t heading;
+} Turtle;
+
+typedef enum {
+    LsysPassMeasure, // walk without drawing to find the bounding box
+    LsysPassDraw,
+    LsysPassHold,
+} LsysPass;
+
+typedef struct {
+    LsysFrame expand[LSYS_MAX_DEPTH + 1];
+    uint8_t expand_sp;
+    char chunk[LSYS_CHUNK];
+    uint8_t chunk_len;
+    uint8_t chunk_pos;
+    Turtle turtle;
+    Turtle saved[LSYS_TURTLE_STACK];
+    uint8_t saved_sp;
+    uint16_t saved_dropped; // pushes beyond the stack, popped as no-ops
+    uint8_t system;
+    uint8_t next_system; // set by Up/Down
+    uint8_t depth;
+    uint8_t pass;
+    uint16_t hold;
+    int32_t step; // 16.16 pixels per F
+    int32_t min_x; // bounds from the measure pass, 16.16
+    int32_t max_x;
+    int32_t min_y;
+    int32_t max_y;
+    uint32_t segments; // drawn this tick
+    uint32_t commands; // expanded so far in this pass
+} LsysState;
+
+// LCD calibration: match dithered patches against line patterns of known
+// coverage, then store the resulting tone-response curve on SD
+#define CALIBRATION_POINTS 3 // 25%, 50%, 75% ink
+#define CALIBRATION_STEP 2
+#define CALIBRATION_PATH APP_DATA_PATH("lcd_response.bin")
+#define CALIBRATION_MAGIC 0x524C4147 // "GALR"
+#define CALIBRATION_VERSION 1
+
+typedef struct {
+    uint8_t point; // which coverage is being matched
+    uint8_t level[CALIBRATION_POINTS]; // input level that looks like it
+    bool saved;
+} CalibrationState;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t level[CALIBRATION_POINTS];
+    uint8_t response[256];
+} CalibrationFile;
+
+// Last frame and parameters, written on exit and shown on the next launch
+// before anything has been generated
+#define SESSION_PATH APP_DATA_PATH("last_frame.bin")
+#define SESSION_MAGIC 0x53534147 // "GASS"
+#define SESSION_VERSION 2
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t mode;
+    uint8_t gradient_type;
+    uint8_t type_offset;
+    bool invert;
+    bool half_res_smooth;
+    // The saved frame has these applied, so the next ones should too
+    uint8_t filter;
+    uint8_t morph;
+    bool auto_levels;
+    uint32_t seed;
+    uint32_t frame_count;
+    float frequency;
+    float noise_scale;
+    float frequency_bias;
+    uint32_t fb[SCREEN_HEIGHT][FB_WORDS];
+} SessionFile;
+
+// Simulation checkpoints: header, framebuffer and the mode's sim struct as
+// one blob. Written a chunk per tick to a temp file that replaces the old
+// checkpoint once complete, and read back in a single call on resume.
+#define CHECKPOINT_PATH APP_DATA_PATH("checkpoint.bin")
+#define CHECKPOINT_TMP_PATH APP_DATA_PATH("checkpoint.tmp")
+#define CHECKPOINT_MAGIC 0x4B434147 // "GACK"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_INTERVAL_FRAMES 900 // ~30 s
+#define CHECKPOINT_CHUNK 256 // bytes written per tick
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t mode;
+    uint16_t sim_size; // guards against a changed struct layout
+    uint32_t seed;
+    uint32_t frame_count;
+} CheckpointHeader;
+
+typedef struct {
+    uint8_t* blob; // snapshot being written, NULL when idle
+    uint32_t size;
+    uint32_t written;
+    Storage* storage;
+    File* file;
+    uint32_t next_frame; // frame_count of the next snapshot
+    bool resume_pending; // first mode entry after launch may resume
+} CheckpointWriter;
+
+// Gradient parameter evolution: one knot sequence per parameter, built from
+// the seed; any frame's parameters are a pure function of the frame number
+#define EVOLVE_KNOTS 64 // curves wrap after EVOLVE_KNOTS knots
+#define EVOLVE_SPAN_SHIFT 6 // 64 frames (~2 s) between knots
+
+typedef struct {
+    uint8_t frequency[EVOLVE_KNOTS]; // smoothstep-interpolated
+    uint8_t noise[EVOLVE_KNOTS];
+    uint8_t gradient_type[EVOLVE_KNOTS]; // held for a whole span
+    bool invert[EVOLVE_KNOTS];
+    uint32_t seed; // seed the knots were built from
+    bool valid;
+    // User adjustments layered on top of the curves
+    uint8_t type_offset; // Up/Down
+    float frequency_bias; // Left/Right
+} ParamCurves;
+
+typedef struct {
+    float frequency;
+    float noise_scale;
+    uint8_t gradient_type;
+    bool invert;
+} ParamSample;
+
+// Split screen: each viewport runs its own gradient from its own curves
+#define SPLIT_MAX_VIEWPORTS 4
+
+typedef struct {
+    ParamCurves curves[SPLIT_MAX_VIEWPORTS];
+    uint8_t viewports; // 2 side by side or 4 quadrants, set by Up/Down
+    uint8_t types[SPLIT_MAX_VIEWPORTS]; // rendered last frame
+    uint32_t viewport_us[SPLIT_MAX_VIEWPORTS];
+} SplitState;
+
+// Tone cycling: the 8-bit field is built once, then each frame only a new
+// 256-entry LUT is made and the field is dithered through it
+typedef enum {
+    CycleStyleRotate, // sawtooth bands rolling through the field
+    CycleStylePulse, // triangle wave, soft bands
+    CycleStyleSweep, // a soft-edged threshold moving through the levels
+    CycleStyleCount,
+} CycleStyle;
+
+typedef struct {
+    uint8_t field[SCREEN_WIDTH * SCREEN_HEIGHT]; // raw level, before tone mapping
+    uint8_t lut[256];
+    uint16_t phase; // 8.8
+    uint8_t style;
+    uint8_t gradient_type;
+    uint32_t build_us; // cost of the one-off field evaluation
+} CycleState;
+
+// Image import: a binary PGM (P5) or PBM (P4) from SD is decoded a few
+// source rows per tick and box-filtered down to 128x64 on the fly; only a
+// small read buffer and one row of column sums are held, never the source
+#define IMAGE_PGM_PATH APP_DATA_PATH("image.pgm")
+#define IMAGE_PBM_PATH APP_DATA_PATH("image.pbm")
+#define IMAGE_CHUNK 256 // bytes per storage read
+#define IMAGE_MAX_SIDE 4096
+#define IMAGE_BUDGET_US 8000 // decode time per tick, out of the 33 ms frame
+
+typedef enum {
+    ImageStyleStill,
+    ImageStyleWarp, // sine displacement of the sample coordinates
+    ImageStyleBlend, // crossfade with the current gradient
+    ImageStyleCycle, // tone cycling over the decoded field
+    ImageStyleCount,
+} ImageStyle;
+
+typedef enum {
+    ImageLoading,
+    ImageReady,
+    ImageMissing,
+    ImageInvalid,
+} ImageStatus;
+
+typedef struct {
+    uint8_t field[SCREEN_WIDTH * SCREEN_HEIGHT]; // ink level, 255 = black
+    uint8_t lut[256]; // tone cycling
+    uint8_t chunk[IMAGE_CHUNK]; // reusable read buffer
+    uint32_t colsum[SCREEN_WIDTH]; // box filter sums for the pending output row
+    Storage* storage;
+    File* file;
+    uint16_t chunk_len;
+    uint16_t chunk_pos;
+    uint16_t src_w;
+    uint16_t src_h;
+    uint16_t maxval;
+    bool bitmap; // P4: 8 pixels per byte, 1 = black
+    uint16_t src_y; // next source row to decode
+    uint16_t rows_summed; // source rows in colsum
+    uint8_t dst_y; // next output row to write
+    uint8_t status;
+    uint8_t style;
+    uint16_t phase; // 8.8
+    uint32_t load_us; // decode time so far
+} ImageState;
+
+// Auto-levels: black and white points from a histogram of the raw levels
+#define LEVELS_CLIP_SHIFT 8 // ignore 1/256 of the samples at each end
+#define LEVELS_MIN_SPAN 48 // near-flat frames are stretched no further
+#define LEVELS_SMOOTH_SHIFT 4 // moving average over ~16 frames
+
+// Inputs of the gradient tone LUT; a copy is kept to detect changes
+typedef struct {
+    float gamma;
+    float contrast;
+    float brightness;
+    bool invert;
+    uint8_t response_version;
+    uint8_t black; // raw level mapped to 0
+    uint8_t white; // raw level mapped to 255
+} ToneParams;
+
+typedef struct {
+    uint8_t pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+    uint32_t fb[SCREEN_HEIGHT][FB_WORDS];
+    uint32_t seed;
+    uint8_t mode;
+    uint8_t active_mode;
+    bool reset_requested;
+    uint8_t gradient_type;
+    float frequency;
+    float noise_scale;
+    bool invert;
+    float gamma;
+    float contrast;
+    float brightness;
+    uint8_t tone_lut[256];
+    uint8_t tone_lut_flipped[256]; // the same with invert flipped, for split viewports
+    // Measured LCD response: desired ink level -> level to feed the ditherer
+    uint8_t response_lut[256];
+    uint8_t response_version;
+    ToneParams tone_built;
+    bool tone_lut_valid;
+    // Filled by gradient_eval while the gradient is generated, so the
+    // levels cost no extra pass over the pixels
+    bool auto_levels; // toggled with a long Down
+    uint16_t histogram[256];
+    uint16_t levels_black; // 8.8, smoothed across frames
+    uint16_t levels_white;
+    uint32_t frame_count;
+    uint32_t frame_us;
+    // Time to first frame, from the start of app allocation
+    uint32_t launch_cycles;
+    bool restored; // fb holds the previous session's last frame
+    bool first_draw_done;
+    bool first_frame_done;
+    CheckpointWriter checkpoint;
+    uint8_t filter; // FilterKind, cycled with a long Left
+    uint32_t filter_us; // filter time in the last frame
+    uint8_t filter_rows[FILTER_WINDOW_MAX][SCREEN_WIDTH]; // sliding row window
+    uint16_t filter_colsum[SCREEN_WIDTH];
+    // Post-dither morphology works on a copy, so simulations that keep their
+    // state in fb are never disturbed; draw_callback blits whichever is current
+    uint8_t morph; // MorphKind, cycled with a long Up
+    uint32_t morph_us;
+    uint32_t morph_fb[SCREEN_HEIGHT][FB_WORDS];
+    uint32_t (*volatile display)[FB_WORDS];
+    // Backpressure between the timer and the GUI thread
+    volatile bool frame_pending; // produced, not yet drawn
+    uint8_t stalled_ticks;
+    uint32_t frames_produced;
+    uint32_t frames_displayed;
+    uint32_t frames_dropped; // replaced before they were drawn
+    uint32_t ticks_skipped; // renders avoided while waiting for a draw
+    uint8_t quality;
+    uint8_t quality_over; // consecutive frames above QUALITY_DOWN_US
+    uint8_t quality_under; // consecutive frames below QUALITY_UP_US
+    bool half_res_smooth; // evaluate smooth gradient types at 64x32 on every tier
+    // Interpolation error vs. full resolution, sampled one row per frame
+    uint32_t half_res_err_sum;
+    uint32_t half_res_err_count;
+    uint8_t half_res_err_max;
+    ParamCurves curves;
+    // Per-mode simulation state, only the active mode's member is valid
+    union {
+        FlowFieldState flow;
+        BoidsState boids;
+        SandState sand;
+        WorleyState worley;
+        DlaState dla;
+        WireframeState wire;
+        SdfState sdf;
+        TileState tiles;
+        LsysState lsys;
+        SplitState split;
+        CycleState cycle;
+        ImageState image;
+        CalibrationState calibration;
+    } sim;
+} GenerativeState;
+
+typedef struct {
+    Gui* gui;
+    ViewPort* view_port;
+    FuriTimer* timer;
+    GenerativeState* state;
+    NotificationApp* notifications;
+    FuriMessageQueue* event_queue;
+    bool running;
+} FlipperGenApp;
+
+// Lightweight pseudo-random number generator
+static uint32_t xorshift32(uint32_t* state) {
+    if(*state == 0) *state = 1; // Prevent zero-lock
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void block_rng_seed(BlockRng* rng, uint32_t seed) {
+    for(int i = 0; i < 4; i++) {
+        rng->lanes[i] = seed ^ (0x9E3779B9 * (i + 1));
+        xorshift32(&rng->lanes[i]);
+    }
+    rng->pos = BLOCK_RNG_WORDS;
+}
+
+// Independent lanes let the core overlap the shift/xor chains
+static void block_rng_refill(BlockRng* rng) {
+    uint32_t a = rng->lanes[0], b = rng->lanes[1], c = rng->lanes[2], d = rng->lanes[3];
+    for(int i = 0; i < BLOCK_RNG_WORDS; i += 4) {
+        a ^= a << 13;
+        b ^= b << 13;
+        c ^= c << 13;
+        d ^= d << 13;
+        a ^= a >> 17;
+        b ^= b >> 17;
+        c ^= c >> 17;
+        d ^= d >> 17;
+        a ^= a << 5;
+        b ^= b << 5;
+        c ^= c << 5;
+        d ^= d << 5;
+        rng->words[i] = a;
+        rng->words[i + 1] = b;
+        rng->words[i + 2] = c;
+        rng->words[i + 3] = d;
+    }
+    rng->lanes[0] = a;
+    rng->lanes[1] = b;
+    rng->lanes[2] = c;
+    rng->lanes[3] = d;
+    rng->pos = 0;
+}
+
+static inline uint32_t block_rng_next(BlockRng* rng) {
+    if(rng->pos >= BLOCK_RNG_WORDS) block_rng_refill(rng);
+    return rng->words[rng->pos++];
+}
+
+// Fast sine approximation using lookup table: 64 steps per turn, so
+// angle + 16 is the cosine
+static int8_t fast_sin(uint8_t angle) {
+    return sine_table[angle & 63];
+}
+
+// Sine table with linear interpolation; angle is 8.8 table steps
+static int32_t fast_sin_fine(uint16_t angle) {
+    int32_t s0 = fast_sin(angle >> 8);
+    int32_t s1 = fast_sin((angle >> 8) + 1);
+    return s0 + (((s1 - s0) * (int32_t)(angle & 0xFF)) >> 8);
+}
+
+static uint32_t isqrt32(uint32_t v) {
+    uint32_t res = 0;
+    uint32_t bit = 1u << 30;
+    while(bit > v) bit >>= 2;
+    while(bit) {
+        if(v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+// Smooth value noise: x/y are 8.8 fixed point lattice coordinates
+static uint8_t smooth_noise(uint32_t x, uint32_t y, uint32_t seed) {
+    uint32_t ix = x >> 8;
+    uint32_t iy = y >> 8;
+    int32_t fx = x & 0xFF;
+    int32_t fy = y & 0xFF;
+    // Smoothstep 3f^2 - 2f^3 in 8-bit fixed point
+    fx = (fx * fx * (768 - 2 * fx)) >> 16;
+    fy = (fy * fy * (768 - 2 * fy)) >> 16;
+
+    int32_t n00 = simple_noise(ix, iy, seed);
+    int32_t n10 = simple_noise(ix + 1, iy, seed);
+    int32_t n01 = simple_noise(ix, iy + 1, seed);
+    int32_t n11 = simple_noise(ix + 1, iy + 1, seed);
+    int32_t top = n00 + (((n10 - n00) * fx) >> 8);
+    int32_t bottom = n01 + (((n11 - n01) * fx) >> 8);
+    return top + (((bottom - top) * fy) >> 8);
+}
+
+// Cycle counter helpers for on-device profiling
+static inline uint32_t perf_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+static uint32_t perf_elapsed_us(uint32_t start_cycles) {
+    return (perf_cycles() - start_cycles) / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static inline void fb_set_pixel(GenerativeState* state, uint32_t x, uint32_t y) {
+    state->fb[y][x >> 5] |= 1u << (x & 31);
+}
+
+static inline bool fb_get_pixel(GenerativeState* state, uint32_t x, uint32_t y) {
+    return (state->fb[y][x >> 5] >> (x & 31)) & 1;
+}
+
+// Horizontal run [x0, x1] on row y, clipped, written a word at a time
+static void fb_hspan(GenerativeState* state, int32_t x0, int32_t x1, int32_t y) {
+    if(y < 0 || y >= SCREEN_HEIGHT) return;
+    if(x0 < 0) x0 = 0;
+    if(x1 > SCREEN_WIDTH - 1) x1 = SCREEN_WIDTH - 1;
+    if(x0 > x1) return;
+
+    uint32_t* row = state->fb[y];
+    int32_t w0 = x0 >> 5;
+    int32_t w1 = x1 >> 5;
+    uint32_t first = ~0u << (x0 & 31);
+    uint32_t last = ~0u >> (31 - (x1 & 31));
+    if(w0 == w1) {
+        row[w0] |= first & last;
+        return;
+    }
+    row[w0] |= first;
+    for(int32_t w = w0 + 1; w < w1; w++) {
+        row[w] = ~0u;
+    }
+    row[w1] |= last;
+}
+
+// Bresenham; x-major lines are emitted as horizontal spans per row
+static void fb_draw_line(GenerativeState* state, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = abs(y1 - y0);
+
+    if(dx >= dy) {
+        if(x0 > x1) {
+            int32_t t = x0;
+            x0 = x1;
+            x1 = t;
+            t = y0;
+            y0 = y1;
+            y1 = t;
+        }
+        int32_t sy = y0 < y1 ? 1 : -1;
+        int32_t err = dx / 2;
+        int32_t run_start = x0;
+        int32_t y = y0;
+        for(int32_t x = x0; x <= x1; x++) {
+            err -= dy;
+            if(err < 0) {
+                fb_hspan(state, run_start, x, y);
+                y += sy;
+                err += dx;
+                run_start = x + 1;
+            }
+        }
+        if(run_start <= x1) fb_hspan(state, run_start, x1, y);
+    } else {
+        if(y0 > y1) {
+            int32_t t = x0;
+            x0 = x1;
+            x1 = t;
+            t = y0;
+            y0 = y1;
+            y1 = t;
+        }
+        int32_t sx = x0 < x1 ? 1 : -1;
+        int32_t err = dy / 2;
+        int32_t x = x0;
+        for(int32_t y = y0; y <= y1; y++) {
+            if(x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+                fb_set_pixel(state, x, y);
+            }
+            err -= dx;
+            if(err < 0) {
+                x += sx;
+                err += dy;
+            }
+        }
+    }
+}
+
+// Rebuild the tone LUT only when one of its inputs has changed
+static void tone_lut_update(GenerativeState* state) {
+    ToneParams params = {
+        .gamma = state->gamma,
+        .contrast = state->contrast,
+        .brightness = state->brightness,
+        .invert = state->invert,
+        .response_version = state->response_version,
+        .black = 0,
+        .white = 255,
+    };
+    // Only gradient mode gathers a histogram
+    if(state->auto_levels && state->active_mode == GenModeGradient) {
+        params.black = (state->levels_black + 128) >> 8;
+        params.white = (state->levels_white + 128) >> 8;
+    }
+    const ToneParams* built = &state->tone_built;
+    if(state->tone_lut_valid && params.gamma == built->gamma && params.contrast == built->contrast &&
+       params.brightness == built->brightness && params.invert == built->invert &&
+       params.response_version == built->response_version && params.black == built->black &&
+       params.white == built->white) {
+        return;
+    }
+
+    float span = params.white - params.black;
+    for(int i = 0; i < 256; i++) {
+        float v = (i - params.black) / span;
+        if(v < 0) v = 0;
+        if(v > 1) v = 1;
+        v = powf(v, params.gamma);
+        v = (v - 0.5f) * params.contrast + 0.5f + params.brightness;
+        if(v < 0) v = 0;
+        if(v > 1) v = 1;
+        float flipped = 1.0f - v;
+        if(params.invert) {
+            flipped = v;
+            v = 1.0f - v;
+        }
+        // The LCD correction rides along in the same lookup
+        state->tone_lut[i] = state->response_lut[(uint8_t)(v * 255 + 0.5f)];
+        state->tone_lut_flipped[i] = state->response_lut[(uint8_t)(flipped * 255 + 0.5f)];
+    }
+    state->tone_built = params;
+    state->tone_lut_valid = true;
+}
+
+static const char* const quality_names[QualityTierCount] = {"FS", "Ord", "Half"};
+
+// Dithering works on a region of state->pixels; x0 and w must be multiples
+// of 32 so every framebuffer word belongs to exactly one region
+
+// Ordered dithering: no error state, each output word is built in registers
+static void dither_ordered(GenerativeState* state, int x0, int y0, int w, int h) {
+    for(int y = y0; y < y0 + h; y++) {
+        const uint8_t* threshold = bayer8[y & 7];
+        const uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+        for(int w32 = x0 >> 5; w32 < (x0 + w) >> 5; w32++) {
+            uint32_t bits = 0;
+            for(int b = 0; b < 32; b++) {
+                if(row[w32 * 32 + b] > threshold[b & 7]) bits |= 1u << b;
+            }
+            state->fb[y][w32] = bits;
+        }
+    }
+}
+
+// Floyd-Steinberg dithering into the packed framebuffer. Error is only
+// pushed to neighbours inside the region, so adjacent regions never bleed
+// into each other at the seams; the region's words must be cleared first.
+static void dither_floyd_steinberg(GenerativeState* state, int x0, int y0, int w, int h) {
+    int x_end = x0 + w;
+    int y_end = y0 + h;
+    for(int y = y0; y < y_end; y++) {
+        for(int x = x0; x < x_end; x++) {
+            int idx = y * SCREEN_WIDTH + x;
+            uint8_t old_pixel = state->pixels[idx];
+            uint8_t new_pixel = old_pixel > 127 ? 255 : 0;
+            state->pixels[idx] = new_pixel;
+            if(new_pixel) fb_set_pixel(state, x, y);
+            
+            int error = old_pixel - new_pixel;
+            
+            // Distribute error to neighbors
+            if(x + 1 < x_end) {
+                int right_idx = y * SCREEN_WIDTH + (x + 1);
+                int new_val = state->pixels[right_idx] + (error * 7) / 16;
+                state->pixels[right_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
+            }
+            
+            if(y + 1 < y_end) {
+                if(x > x0) {
+                    int bl_idx = (y + 1) * SCREEN_WIDTH + (x - 1);
+                    int new_val = state->pixels[bl_idx] + (error * 3) / 16;
+                    state->pixels[bl_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
+                }
+                
+                int bottom_idx = (y + 1) * SCREEN_WIDTH + x;
+                int new_val = state->pixels[bottom_idx] + (error * 5) / 16;
+                state->pixels[bottom_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
+                
+                if(x + 1 < x_end) {
+                    int br_idx = (y + 1) * SCREEN_WIDTH + (x + 1);
+                    int new_val = state->pixels[br_idx] + (error * 1) / 16;
+                    state->pixels[br_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
+                }
+            }
+        }
+    }
+}
+
+static const char* const filter_names[FilterCount] = {"none", "blur", "gauss", "sharpen", "edges"};
+
+static inline uint8_t filter_average(uint32_t sum, uint32_t n) {
+    return (sum * reciprocal_table[n] + 32768) >> 16;
+}
+
+// Horizontal box average of radius r, edges clamped: one add and one
+// subtract per pixel whatever the radius
+static void filter_box_row(const uint8_t* src, uint8_t* dst, int w, int r) {
+    uint32_t sum = 0;
+    for(int x = 0; x <= r && x < w; x++) {
+        sum += src[x];
+    }
+    for(int x = 0; x < w; x++) {
+        int lo = x - r > 0 ? x - r : 0;
+        int hi = x + r < w - 1 ? x + r : w - 1;
+        dst[x] = filter_average(sum, hi - lo + 1);
+        if(x + r + 1 < w) sum += src[x + r + 1];
+        if(x - r >= 0) sum -= src[x - r];
+    }
+}
+
+// Box blur (or unsharp mask) over a region in place. Each row is blurred
+// horizontally into a slot of the 2r + 1 row window and added to running
+// column sums; output row y is written once rows up to y + r are in, and
+// the row leaving the window is subtracted from the sums.
+static void filter_box(GenerativeState* state, int x0, int y0, int w, int h, int r, bool sharpen) {
+    int window = 2 * r + 1;
+    int y_end = y0 + h;
+    uint16_t* colsum = state->filter_colsum;
+    memset(colsum, 0, w * sizeof(uint16_t));
+
+    for(int k = y0; k < y_end + r; k++) {
+        uint8_t* slot = state->filter_rows[(k - y0) % window];
+        if(k - window >= y0) {
+            for(int x = 0; x < w; x++) colsum[x] -= slot[x];
+        }
+        if(k < y_end) {
+            filter_box_row(&state->pixels[k * SCREEN_WIDTH + x0], slot, w, r);
+            for(int x = 0; x < w; x++) colsum[x] += slot[x];
+        }
+
+        int y = k - r;
+        if(y < y0) continue;
+        int lo = y - r > y0 ? y - r : y0;
+        int hi = y + r < y_end - 1 ? y + r : y_end - 1;
+        uint32_t n = hi - lo + 1;
+        // Row y itself is still unfiltered: its blurred copy is in the window
+        uint8_t* out = &state->pixels[y * SCREEN_WIDTH + x0];
+        for(int x = 0; x < w; x++) {
+            int blur = filter_average(colsum[x], n);
+            if(sharpen) {
+                int v = 2 * out[x] - blur;
+                out[x] = v < 0 ? 0 : v > 255 ? 255 : v;
+            } else {
+                out[x] = blur;
+            }
+        }
+    }
+}
+
+// Sobel as its separable halves: per column a vertical [1 2 1] smooth and
+// a vertical [-1 0 1] difference, combined horizontally as the row
+// advances. Only the previous input row needs to be kept.
+static void filter_sobel(GenerativeState* state, int x0, int y0, int w, int h) {
+    int y_end = y0 + h;
+    uint8_t* prev = state->filter_rows[0];
+    uint8_t* cur = state->filter_rows[1];
+    memcpy(prev, &state->pixels[y0 * SCREEN_WIDTH + x0], w); // top edge clamps
+
+    for(int y = y0; y < y_end; y++) {
+        uint8_t* out = &state->pixels[y * SCREEN_WIDTH + x0];
+        memcpy(cur, out, w);
+        const uint8_t* next = y + 1 < y_end ? out + SCREEN_WIDTH : cur;
+
+        int s_left = prev[0] + 2 * cur[0] + next[0];
+        int d_left = next[0] - prev[0];
+        int s_mid = s_left;
+        int d_mid = d_left;
+        for(int x = 0; x < w; x++) {
+            int xr = x + 1 < w ? x + 1 : x;
+            int s_right = prev[xr] + 2 * cur[xr] + next[xr];
+            int d_right = next[xr] - prev[xr];
+            int gx = s_right - s_left;
+            int gy = d_left + 2 * d_mid + d_right;
+            int mag = (abs(gx) + abs(gy)) >> 2;
+            out[x] = mag > 255 ? 255 : mag;
+            s_left = s_mid;
+            d_left = d_mid;
+            s_mid = s_right;
+            d_mid = d_right;
+        }
+
+        uint8_t* t = prev;
+        prev = cur;
+        cur = t;
+    }
+}
+
+static void filter_apply(GenerativeState* state, int x0, int y0, int w, int h) {
+    uint32_t start = perf_cycles();
+    switch(state->filter) {
+        case FilterBlur:
+            filter_box(state, x0, y0, w, h, 2, false);
+            break;
+        case FilterGaussian:
+            filter_box(state, x0, y0, w, h, 2, false);
+            filter_box(state, x0, y0, w, h, 2, false);
+            break;
+        case FilterSharpen:
+            filter_box(state, x0, y0, w, h, 1, true);
+            break;
+        case FilterEdges:
+            filter_sobel(state, x0, y0, w, h);
+            break;
+        default:
+            break;
+    }
+    state->filter_us += perf_elapsed_us(start);
+}
+
+// Quantise one region of state->pixels at the current quality tier
+static void apply_dither_region(GenerativeState* state, int x0, int y0, int w, int h) {
+    if(state->filter != FilterNone) {
+        filter_apply(state, x0, y0, w, h);
+    }
+    if(state->quality == QualityFloydSteinberg) {
+        for(int y = y0; y < y0 + h; y++) {
+            memset(&state->fb[y][x0 >> 5], 0, (w >> 5) * sizeof(uint32_t));
+        }
+        dither_floyd_steinberg(state, x0, y0, w, h);
+    } else {
+        dither_ordered(state, x0, y0, w, h);
+    }
+}
+
+// Quantise state->pixels into the framebuffer at the current quality tier
+static void apply_dither(GenerativeState* state) {
+    apply_dither_region(state, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+static const char* const morph_names[MorphCount] = {
+    "none", "dilate", "erode", "open", "close", "outline", "edge inv"};
+
+typedef enum {
+    MorphPassDilate,
+    MorphPassErode,
+    MorphPassOutline,
+    MorphPassEdgeInvert,
+} MorphPass;
+
+// Horizontal 3-pixel OR of one row, carrying bits across word boundaries.
+// Erosion spreads the complement instead: erode(a) = ~dilate(~a).
+static inline void morph_spread(const uint32_t* in, bool complement, uint32_t* out) {
+    uint32_t flip = complement ? ~0u : 0;
+    uint32_t prev = 0;
+    uint32_t cur = in[0] ^ flip;
+    for(int w = 0; w < FB_WORDS; w++) {
+        uint32_t next = w < FB_WORDS - 1 ? in[w + 1] ^ flip : 0;
+        out[w] = cur | (cur << 1) | (prev >> 31) | (cur >> 1) | (next << 31);
+        prev = cur;
+        cur = next;
+    }
+}
+
+// One 3x3 pass, in place. Only the spread rows y-1, y and y+1 are kept, and
+// row y+1 is spread before row y is overwritten. Off-screen pixels count as
+// paper for dilation and as ink for erosion, so the border never eats shapes.
+static void morph_pass(uint32_t (*fb)[FB_WORDS], MorphPass pass) {
+    bool need_dilate = pass != MorphPassErode && pass != MorphPassOutline;
+    bool need_erode = pass != MorphPassDilate;
+    uint32_t dil[3][FB_WORDS] = {0};
+    uint32_t ero[3][FB_WORDS] = {0};
+
+    if(need_dilate) morph_spread(fb[0], false, dil[0]);
+    if(need_erode) morph_spread(fb[0], true, ero[0]);
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        // Slots are reused round-robin; OR does not care about their order
+        int slot = (y + 1) % 3;
+        if(y + 1 < SCREEN_HEIGHT) {
+            if(need_dilate) morph_spread(fb[y + 1], false, dil[slot]);
+            if(need_erode) morph_spread(fb[y + 1], true, ero[slot]);
+        } else {
+            memset(dil[slot], 0, sizeof(dil[slot]));
+            memset(ero[slot], 0, sizeof(ero[slot]));
+        }
+        for(int w = 0; w < FB_WORDS; w++) {
+            uint32_t d = dil[0][w] | dil[1][w] | dil[2][w];
+            uint32_t e = ~(ero[0][w] | ero[1][w] | ero[2][w]);
+            switch(pass) {
+                case MorphPassDilate:
+                    fb[y][w] = d;
+                    break;
+                case MorphPassErode:
+                    fb[y][w] = e;
+                    break;
+                case MorphPassOutline:
+                    fb[y][w] &= ~e;
+                    break;
+                case MorphPassEdgeInvert:
+                    fb[y][w] ^= d & ~e;
+                    break;
+            }
+        }
+    }
+}
+
+// Run the selected effect on a copy of fb and point the display at it
+static void morph_apply(GenerativeState* state) {
+    if(state->morph == MorphNone || state->active_mode == GenModeCalibrate) {
+        state->display = state->fb;
+        state->morph_us = 0;
+        return;
+    }
+
+    uint32_t start = perf_cycles();
+    memcpy(state->morph_fb, state->fb, sizeof(state->morph_fb));
+    switch(state->morph) {
+        case MorphDilate:
+            morph_pass(state->morph_fb, MorphPassDilate);
+            break;
+        case MorphErode:
+            morph_pass(state->morph_fb, MorphPassErode);
+            break;
+        case MorphOpen:
+            morph_pass(state->morph_fb, MorphPassErode);
+            morph_pass(state->morph_fb, MorphPassDilate);
+            break;
+        case MorphClose:
+            morph_pass(state->morph_fb, MorphPassDilate);
+            morph_pass(state->morph_fb, MorphPassErode);
+            break;
+        case MorphOutline:
+            morph_pass(state->morph_fb, MorphPassOutline);
+            break;
+        case MorphEdgeInvert:
+            morph_pass(state->morph_fb, MorphPassEdgeInvert);
+            break;
+        default:
+            break;
+    }
+    state->morph_us = perf_elapsed_us(start);
+    state->display = state->morph_fb;
+}
+
+// Rebuild the coarse vector grid from two drifting noise layers
+static void flow_field_update(GenerativeState* state) {
+    FlowFieldState* flow = &state->sim.flow;
+    uint32_t step = (uint32_t)(state->frequency * 64); // lattice units per cell, 8.8
+    uint32_t drift = state->frame_count * 2;
+
+    for(int cy = 0; cy < FLOW_GRID_H; cy++) {
+        for(int cx = 0; cx < FLOW_GRID_W; cx++) {
+            uint32_t nx = cx * step;
+            uint32_t ny = cy * step;
+            uint8_t a = smooth_noise(nx + drift, ny, state->seed);
+            uint8_t b = smooth_noise(nx, ny + drift, state->seed ^ 0x9E3779B9);
+            uint8_t angle = (uint8_t)(a + b) >> 1; // two turns over the noise range
+            flow->field_x[cy][cx] = fast_sin(angle + 16);
+            flow->field_y[cy][cx] = fast_sin(angle);
+        }
+    }
+}
+
+static void flow_field_respawn(FlowFieldState* flow, uint32_t i) {
+    flow->x[i] = xorshift32(&flow->rng) & 0x7FFF;
+    flow->y[i] = xorshift32(&flow->rng) & 0x3FFF;
+    flow->vx[i] = 0;
+    flow->vy[i] = 0;
+}
+
+static void flow_field_init(GenerativeState* state) {
+    FlowFieldState* flow = &state->sim.flow;
+    flow->rng = state->seed;
+    flow->fade = 3;
+    for(uint32_t i = 0; i < FLOW_PARTICLES; i++) {
+        flow_field_respawn(flow, i);
+    }
+}
+
+// Advance every particle one step and plot it; trails fade via random masks
+static void flow_field_step(GenerativeState* state) {
+    FlowFieldState* flow = &state->sim.flow;
+
+    // Each AND with a random word clears ~half the bits it touches, so a
+    // pixel survives the frame unless all `fade` random bits are zero.
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        for(int w = 0; w < FB_WORDS; w++) {
+            uint32_t keep = 0;
+            for(uint8_t k = 0; k < flow->fade; k++) {
+                keep |= xorshift32(&flow->rng);
+            }
+            state->fb[y][w] &= keep;
+        }
+    }
+
+    flow_field_update(state);
+
+    uint16_t* px = flow->x;
+    uint16_t* py = flow->y;
+    int16_t* vx = flow->vx;
+    int16_t* vy = flow->vy;
+    for(uint32_t i = 0; i < FLOW_PARTICLES; i++) {
+        uint32_t cx = px[i] >> (8 + FLOW_CELL_SHIFT);
+        uint32_t cy = py[i] >> (8 + FLOW_CELL_SHIFT);
+        // Steer toward the field vector (~0.75 px/frame at full strength)
+        int32_t tx = flow->field_x[cy][cx] * 3;
+        int32_t ty = flow->field_y[cy][cx] * 3;
+        vx[i] += (tx - vx[i]) >> 2;
+        vy[i] += (ty - vy[i]) >> 2;
+        px[i] = (px[i] + vx[i]) & 0x7FFF;
+        py[i] = (py[i] + vy[i]) & 0x3FFF;
+        fb_set_pixel(state, px[i] >> 8, py[i] >> 8);
+    }
+
+    // Recycle a slice of the pool so particles don't all pile into sinks
+    uint32_t slice = FLOW_PARTICLES >> FLOW_RESPAWN_SHIFT;
+    uint32_t first = (state->frame_count * slice) & (FLOW_PARTICLES - 1);
+    for(uint32_t i = 0; i < slice; i++) {
+        flow_field_respawn(flow, first + i);
+    }
+}
+
+static void boids_init(GenerativeState* state) {
+    BoidsState* boids = &state->sim.boids;
+    boids->rng = state->seed;
+    boids->count = 256;
+    for(uint32_t i = 0; i < BOIDS_MAX; i++) {
+        uint8_t heading = xorshift32(&boids->rng);
+        boids->x[i] = xorshift32(&boids->rng) & 0x7FFF;
+        boids->y[i] = xorshift32(&boids->rng) & 0x3FFF;
+        boids->vx[i] = fast_sin(heading + 16) * 3;
+        boids->vy[i] = fast_sin(heading) * 3;
+    }
+}
+
+// Bucket boids by cell with a two-pass counting sort (no per-cell lists)
+static void boids_build_grid(BoidsState* boids, uint32_t count) {
+    uint16_t* start = boids->cell_start;
+    memset(start, 0, sizeof(boids->cell_start));
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t cx = boids->x[i] >> (8 + BOIDS_CELL_SHIFT);
+        uint32_t cy = boids->y[i] >> (8 + BOIDS_CELL_SHIFT);
+        uint8_t c = cy * BOIDS_GRID_W + cx;
+        boids->cell[i] = c;
+        start[c + 1]++;
+    }
+    for(uint32_t c = 0; c < BOIDS_CELLS; c++) {
+        start[c + 1] += start[c];
+    }
+    // Scatter using cell_start[c] as the write cursor, then shift it back
+    for(uint32_t i = 0; i < count; i++) {
+        boids->order[start[boids->cell[i]]++] = i;
+    }
+    for(uint32_t c = BOIDS_CELLS; c > 0; c--) {
+        start[c] = start[c - 1];
+    }
+    start[0] = 0;
+}
+
+// Separation, alignment and cohesion against the 3x3 neighbouring cells
+static void boids_step(GenerativeState* state) {
+    BoidsState* boids = &state->sim.boids;
+    uint32_t count = boids->count;
+    const int32_t view_r2 = 128 * 128; // 8 px, in 1/16 px units
+    const int32_t sep_r2 = 40 * 40; // 2.5 px
+    const int32_t max_speed2 = 256 * 256; // 1 px/frame, in 8.8 units
+    const int32_t min_speed2 = 128 * 128;
+
+    boids_build_grid(boids, count);
+
+    for(uint32_t i = 0; i < count; i++) {
+        int32_t cx = boids->x[i] >> (8 + BOIDS_CELL_SHIFT);
+        int32_t cy = boids->y[i] >> (8 + BOIDS_CELL_SHIFT);
+        int32_t neighbours = 0;
+        int32_t sum_vx = 0, sum_vy = 0;
+        int32_t sum_dx = 0, sum_dy = 0;
+        int32_t sep_x = 0, sep_y = 0;
+
+        for(int32_t oy = -1; oy <= 1; oy++) {
+            int32_t ny = (cy + oy + BOIDS_GRID_H) % BOIDS_GRID_H;
+            for(int32_t ox = -1; ox <= 1; ox++) {
+                int32_t nx = (cx + ox + BOIDS_GRID_W) % BOIDS_GRID_W;
+                uint32_t c = ny * BOIDS_GRID_W + nx;
+                for(uint32_t k = boids->cell_start[c]; k < boids->cell_start[c + 1]; k++) {
+                    uint32_t j = boids->order[k];
+                    if(j == i) continue;
+                    // Shortest offset on the torus, 8.8 fixed point
+                    int32_t dx = (int32_t)((boids->x[j] - boids->x[i] + 0x4000) & 0x7FFF) - 0x4000;
+                    int32_t dy = (int32_t)((boids->y[j] - boids->y[i] + 0x2000) & 0x3FFF) - 0x2000;
+                    int32_t d2 = (dx >> 4) * (dx >> 4) + (dy >> 4) * (dy >> 4);
+                    if(d2 >= view_r2) continue;
+                    neighbours++;
+                    sum_vx += boids->vx[j];
+                    sum_vy += boids->vy[j];
+                    sum_dx += dx;
+                    sum_dy += dy;
+                    if(d2 < sep_r2) {
+                        sep_x -= dx;
+                        sep_y -= dy;
+                    }
+                }
+            }
+        }
+
+        int32_t vx = boids->vx[i];
+        int32_t vy = boids->vy[i];
+        if(neighbours) {
+            vx += (sum_vx / neighbours - vx) >> 3; // alignment
+            vy += (sum_vy / neighbours - vy) >> 3;
+            vx += (sum_dx / neighbours) >> 6; // cohesion
+            vy += (sum_dy / neighbours) >> 6;
+            vx += sep_x >> 2; // separation
+            vy += sep_y >> 2;
+        }
+
+        // Nudge speed back into range without a square root
+        int32_t speed2 = vx * vx + vy * vy;
+        if(speed2 > max_speed2) {
+            vx = vx * 3 / 4;
+            vy = vy * 3 / 4;
+        } else if(speed2 < min_speed2) {
+            vx = vx * 5 / 4 + 1;
+            vy = vy * 5 / 4;
+        }
+        boids->next_vx[i] = vx;
+        boids->next_vy[i] = vy;
+    }
+
+    memset(state->fb, 0, sizeof(state->fb));
+    for(uint32_t i = 0; i < count; i++) {
+        boids->vx[i] = boids->next_vx[i];
+        boids->vy[i] = boids->next_vy[i];
+        boids->x[i] = (boids->x[i] + boids->vx[i]) & 0x7FFF;
+        boids->y[i] = (boids->y[i] + boids->vy[i]) & 0x3FFF;
+        // Two-pixel sprite: head plus a tail one step behind
+        uint16_t tail_x = (boids->x[i] - boids->vx[i] * 2) & 0x7FFF;
+        uint16_t tail_y = (boids->y[i] - boids->vy[i] * 2) & 0x3FFF;
+        fb_set_pixel(state, boids->x[i] >> 8, boids->y[i] >> 8);
+        fb_set_pixel(state, tail_x >> 8, tail_y >> 8);
+    }
+}
+
+// 128-bit row helpers; bit x is pixel x, so "<< 1" moves pixels right
+static inline void row_shl1(const uint32_t* in, uint32_t* out) {
+    for(int w = FB_WORDS - 1; w > 0; w--) {
+        out[w] = (in[w] << 1) | (in[w - 1] >> 31);
+    }
+    out[0] = in[0] << 1;
+}
+
+static inline void row_shr1(const uint32_t* in, uint32_t* out) {
+    for(int w = 0; w < FB_WORDS - 1; w++) {
+        out[w] = (in[w] >> 1) | (in[w + 1] << 31);
+    }
+    out[FB_WORDS - 1] = in[FB_WORDS - 1] >> 1;
+}
+
+static void sand_init(GenerativeState* state) {
+    SandState* sand = &state->sim.sand;
+    block_rng_seed(&sand->rng, state->seed);
+    sand->steps_per_frame = SAND_STEPS_DEFAULT;
+    sand->draining = false;
+}
+
+// One gravity step for every row, bottom-up so a grain moves at most once
+static void sand_step(GenerativeState* state) {
+    SandState* sand = &state->sim.sand;
+    uint32_t shifted[FB_WORDS];
+    uint32_t go[FB_WORDS];
+
+    if(sand->draining) {
+        memset(state->fb[SCREEN_HEIGHT - 1], 0, sizeof(state->fb[0]));
+    }
+
+    for(int y = SCREEN_HEIGHT - 2; y >= 0; y--) {
+        uint32_t* cur = state->fb[y];
+        uint32_t* below = state->fb[y + 1];
+
+        // Straight down wherever the cell below is free
+        for(int w = 0; w < FB_WORDS; w++) {
+            uint32_t fall = cur[w] & ~below[w];
+            below[w] |= fall;
+            cur[w] &= ~fall;
+        }
+
+        // Blocked grains slide diagonally; the RNG breaks ties when both
+        // sides are open. Left moves land first so targets never collide.
+        uint32_t can_right[FB_WORDS];
+        row_shr1(below, shifted); // bit x = below-right occupied
+        for(int w = 0; w < FB_WORDS; w++) {
+            can_right[w] = cur[w] & ~shifted[w];
+        }
+        can_right[FB_WORDS - 1] &= 0x7FFFFFFF;
+        row_shl1(below, shifted); // bit x = below-left occupied
+        for(int w = 0; w < FB_WORDS; w++) {
+            uint32_t can_left = cur[w] & ~shifted[w];
+            if(w == 0) can_left &= ~1u;
+            go[w] = can_left & (block_rng_next(&sand->rng) | ~can_right[w]);
+            cur[w] &= ~go[w];
+        }
+        row_shr1(go, shifted);
+        for(int w = 0; w < FB_WORDS; w++) {
+            below[w] |= shifted[w];
+        }
+
+        row_shr1(below, shifted);
+        for(int w = 0; w < FB_WORDS; w++) {
+            go[w] = cur[w] & ~shifted[w];
+        }
+        go[FB_WORDS - 1] &= 0x7FFFFFFF;
+        for(int w = 0; w < FB_WORDS; w++) {
+            cur[w] &= ~go[w];
+        }
+        row_shl1(go, shifted);
+        for(int w = 0; w < FB_WORDS; w++) {
+            below[w] |= shifted[w];
+        }
+    }
+}
+
+static void sand_frame(GenerativeState* state) {
+    SandState* sand = &state->sim.sand;
+
+    // Swaying emitters pour a few random grains into the top row
+    for(int e = 0; e < SAND_EMITTERS; e++) {
+        uint8_t phase = (uint8_t)(state->frame_count * state->frequency) + e * 21;
+        int32_t x = SCREEN_WIDTH / 2 + fast_sin(phase) * (e + 1) * 20 / 64 + (e - 1) * 32;
+        if(x < 2) x = 2;
+        if(x > SCREEN_WIDTH - 3) x = SCREEN_WIDTH - 3;
+        uint32_t bits = block_rng_next(&sand->rng);
+        for(int i = -2; i <= 2; i++) {
+            if(bits & (1u << (i + 2))) fb_set_pixel(state, x + i, 0);
+        }
+    }
+
+    for(uint8_t i = 0; i < sand->steps_per_frame; i++) {
+        sand_step(state);
+    }
+
+    // Open the floor once the pile gets high, close it when it has run out
+    uint32_t high = 0, low = 0;
+    for(int w = 0; w < FB_WORDS; w++) {
+        high += __builtin_popcount(state->fb[SAND_DRAIN_ROW][w]);
+        low += __builtin_popcount(state->fb[SCREEN_HEIGHT - 8][w]);
+    }
+    if(high > SCREEN_WIDTH / 4) sand->draining = true;
+    if(low < SCREEN_WIDTH / 16) sand->draining = false;
+}
+
+static void worley_init(GenerativeState* state) {
+    WorleyState* worley = &state->sim.worley;
+    uint32_t rng = state->seed;
+    for(int cy = 0; cy < WORLEY_GRID_H; cy++) {
+        for(int cx = 0; cx < WORLEY_GRID_W; cx++) {
+            worley->phase[cy][cx] = xorshift32(&rng);
+        }
+    }
+    worley->variant = WorleyF1;
+}
+
+// Sites wander on small Lissajous paths that never leave their own cell
+static void worley_move_sites(GenerativeState* state) {
+    WorleyState* worley = &state->sim.worley;
+    uint8_t t = (uint8_t)(state->frame_count * state->frequency);
+    for(int cy = 0; cy < WORLEY_GRID_H; cy++) {
+        for(int cx = 0; cx < WORLEY_GRID_W; cx++) {
+            uint8_t p = worley->phase[cy][cx];
+            int32_t ox = fast_sin(t + p) * 7 / 64;
+            int32_t oy = fast_sin((uint8_t)(t * 2) + (p >> 2) + 16) * 7 / 64;
+            worley->site_x[cy][cx] = cx * WORLEY_CELL + WORLEY_CELL / 2 + ox;
+            worley->site_y[cy][cx] = cy * WORLEY_CELL + WORLEY_CELL / 2 + oy;
+        }
+    }
+}
+
+// Fill state->pixels with cellular noise, then hand off to the ditherer
+static void worley_frame(GenerativeState* state) {
+    WorleyState* worley = &state->sim.worley;
+    uint8_t cand_x[WORLEY_GRID_W][WORLEY_CANDIDATES];
+    uint8_t cand_y[WORLEY_GRID_W][WORLEY_CANDIDATES];
+    uint8_t cand_count[WORLEY_GRID_W];
+    int32_t dy2[WORLEY_CANDIDATES];
+    bool edges = worley->variant == WorleyEdges;
+    bool half = state->quality == QualityHalfRes;
+
+    worley_move_sites(state);
+
+    for(int cy = 0; cy < WORLEY_GRID_H; cy++) {
+        // Candidate lists are shared by every pixel row in this band of cells
+        for(int cx = 0; cx < WORLEY_GRID_W; cx++) {
+            uint8_t n = 0;
+            for(int ny = cy - 1; ny <= cy + 1; ny++) {
+                if(ny < 0 || ny >= WORLEY_GRID_H) continue;
+                for(int nx = cx - 1; nx <= cx + 1; nx++) {
+                    if(nx < 0 || nx >= WORLEY_GRID_W) continue;
+                    cand_x[cx][n] = worley->site_x[ny][nx];
+                    cand_y[cx][n] = worley->site_y[ny][nx];
+                    n++;
+                }
+            }
+            cand_count[cx] = n;
+        }
+
+        for(int y = cy * WORLEY_CELL; y < (cy + 1) * WORLEY_CELL; y++) {
+            uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+            if(half && (y & 1)) {
+                memcpy(row, row - SCREEN_WIDTH, SCREEN_WIDTH);
+                continue;
+            }
+            for(int cx = 0; cx < WORLEY_GRID_W; cx++) {
+                uint8_t n = cand_count[cx];
+                // dy^2 is constant along the row, so only dx varies per pixel
+                for(uint8_t k = 0; k < n; k++) {
+                    int32_t dy = (int32_t)cand_y[cx][k] - y;
+                    dy2[k] = dy * dy;
+                }
+                for(int x = cx * WORLEY_CELL; x < (cx + 1) * WORLEY_CELL; x++) {
+                    if(half && (x & 1)) {
+                        row[x] = row[x - 1];
+                        continue;
+                    }
+                    int32_t f1 = INT32_MAX;
+                    int32_t f2 = INT32_MAX;
+                    for(uint8_t k = 0; k < n; k++) {
+                        int32_t dx = (int32_t)cand_x[cx][k] - x;
+                        int32_t d2 = dx * dx + dy2[k];
+                        if(d2 < f1) {
+                            f2 = f1;
+                            f1 = d2;
+                        } else if(d2 < f2) {
+                            f2 = d2;
+                        }
+                    }
+                    // Squared distances; typical F1 spans 0..~120 in 16 px cells
+                    int32_t value = edges ? 255 - (f2 - f1) * 2 : f1 * 2;
+                    row[x] = state->response_lut[value < 0 ? 0 : value > 255 ? 255 : value];
+                }
+            }
+        }
+    }
+
+    apply_dither(state);
+}
+
+static void dla_spawn(DlaState* dla, uint32_t i) {
+    uint32_t r = block_rng_next(&dla->rng);
+    dla->x[i] = 1 + (r & 0xFFFF) % (SCREEN_WIDTH - 2);
+    dla->y[i] = 1 + (r >> 16) % (SCREEN_HEIGHT - 2);
+}
+
+// Freeze a pixel into the cluster and tighten the coarse distance map
+static void dla_stick(GenerativeState* state, int32_t x, int32_t y) {
+    DlaState* dla = &state->sim.dla;
+    fb_set_pixel(state, x, y);
+    dla->stuck++;
+
+    int32_t sx = x >> DLA_CELL_SHIFT;
+    int32_t sy = y >> DLA_CELL_SHIFT;
+    for(int32_t cy = 0; cy < DLA_GRID_H; cy++) {
+        for(int32_t cx = 0; cx < DLA_GRID_W; cx++) {
+            int32_t dx = abs(cx - sx);
+            int32_t dy = abs(cy - sy);
+            uint8_t d = dx > dy ? dx : dy;
+            if(d < dla->dist[cy][cx]) dla->dist[cy][cx] = d;
+        }
+    }
+
+    // Stop growing once the cluster nears the screen edge
+    if(x < 3 || y < 3 || x > SCREEN_WIDTH - 4 || y > SCREEN_HEIGHT - 4) {
+        dla->hold = DLA_HOLD_FRAMES;
+    }
+}
+
+static void dla_init(GenerativeState* state) {
+    DlaState* dla = &state->sim.dla;
+    block_rng_seed(&dla->rng, state->seed);
+    memset(dla->dist, 0xFF, sizeof(dla->dist));
+    dla->stuck = 0;
+    dla->steps = 0;
+    dla->hold = 0;
+    dla_stick(state, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+    for(uint32_t i = 0; i < DLA_WALKERS; i++) {
+        dla_spawn(dla, i);
+    }
+}
+
+static bool dla_touches_cluster(GenerativeState* state, int32_t x, int32_t y) {
+    for(int32_t ny = y - 1; ny <= y + 1; ny++) {
+        for(int32_t nx = x - 1; nx <= x + 1; nx++) {
+            if(fb_get_pixel(state, nx, ny)) return true;
+        }
+    }
+    return false;
+}
+
+// Walk until the tick's time budget runs out; growth resumes next tick
+static void dla_frame(GenerativeState* state) {
+    DlaState* dla = &state->sim.dla;
+    uint32_t start = perf_cycles();
+    uint32_t budget = DLA_BUDGET_US * furi_hal_cortex_instructions_per_microsecond();
+    uint32_t steps = 0;
+
+    if(dla->hold) {
+        if(--dla->hold == 0) {
+            state->seed = xorshift32(&state->seed);
+            state->reset_requested = true;
+        }
+        dla->steps = 0;
+        return;
+    }
+
+    while(perf_cycles() - start < budget && !dla->hold) {
+        for(uint32_t i = 0; i < DLA_WALKERS; i++) {
+            int32_t x = dla->x[i];
+            int32_t y = dla->y[i];
+            uint8_t d = dla->dist[y >> DLA_CELL_SHIFT][x >> DLA_CELL_SHIFT];
+            uint32_t r = block_rng_next(&dla->rng);
+
+            if(d >= 2) {
+                // At least (d - 1) * 8 + 1 px from the cluster: a jump of
+                // (d - 1) * 8 - 1 px in any direction cannot land adjacent
+                int32_t reach = (d - 1) * (1 << DLA_CELL_SHIFT) - 1;
+                x += (int32_t)((r & 0xFFFF) % (2 * reach + 1)) - reach;
+                y += (int32_t)((r >> 16) % (2 * reach + 1)) - reach;
+            } else {
+                switch(r & 3) {
+                    case 0: x++; break;
+                    case 1: x--; break;
+                    case 2: y++; break;
+                    default: y--; break;
+                }
+            }
+            if(x < 1) x = 1;
+            if(y < 1) y = 1;
+            if(x > SCREEN_WIDTH - 2) x = SCREEN_WIDTH - 2;
+            if(y > SCREEN_HEIGHT - 2) y = SCREEN_HEIGHT - 2;
+
+            if(fb_get_pixel(state, x, y)) {
+                dla_spawn(dla, i);
+                continue;
+            }
+            if(dla_touches_cluster(state, x, y)) {
+                dla_stick(state, x, y);
+                dla_spawn(dla, i);
+                continue;
+            }
+            dla->x[i] = x;
+            dla->y[i] = y;
+        }
+        steps += DLA_WALKERS;
+    }
+    dla->steps = steps;
+}
+
+static const int8_t cube_vertices[][3] = {
+    {-32, -32, -32}, {32, -32, -32}, {32, 32, -32}, {-32, 32, -32},
+    {-32, -32, 32}, {32, -32, 32}, {32, 32, 32}, {-32, 32, 32},
+};
+static const uint8_t cube_edges[][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6},
+    {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+};
+static const int8_t octahedron_vertices[][3] = {
+    {44, 0, 0}, {-44, 0, 0}, {0, 44, 0}, {0, -44, 0}, {0, 0, 44}, {0, 0, -44},
+};
+static const uint8_t octahedron_edges[][2] = {
+    {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {1, 3},
+    {1, 4}, {1, 5}, {2, 4}, {4, 3}, {3, 5}, {5, 2},
+};
+
+static void wireframe_spawn_star(WireframeState* wire, uint32_t i, uint8_t z) {
+    wire->star_x[i] = (int16_t)(xorshift32(&wire->rng) & 0x7FF) - 1024;
+    wire->star_y[i] = (int16_t)(xorshift32(&wire->rng) & 0x7FF) - 1024;
+    wire->star_z[i] = z;
+}
+
+static void wireframe_init(GenerativeState* state) {
+    WireframeState* wire = &state->sim.wire;
+    wire->rng = state->seed;
+    wire->angle_x = 0;
+    wire->angle_y = 0;
+    wire->solid = WireSolidCube;
+    for(uint32_t i = 0; i < WIRE_STARS; i++) {
+        wireframe_spawn_star(wire, i, 1 + xorshift32(&wire->rng) % (COUNT_OF(reciprocal_table) - 1));
+    }
+}
+
+static void wireframe_frame(GenerativeState* state) {
+    WireframeState* wire = &state->sim.wire;
+    memset(state->fb, 0, sizeof(state->fb));
+
+    // Starfield: stars fly toward the camera and respawn at the far plane
+    for(uint32_t i = 0; i < WIRE_STARS; i++) {
+        if(wire->star_z[i] <= 4) wireframe_spawn_star(wire, i, COUNT_OF(reciprocal_table) - 1);
+        wire->star_z[i] -= 2;
+        uint16_t inv = reciprocal_table[wire->star_z[i]];
+        int32_t sx = SCREEN_WIDTH / 2 + ((wire->star_x[i] * inv) >> 12);
+        int32_t sy = SCREEN_HEIGHT / 2 + ((wire->star_y[i] * inv) >> 12);
+        if(wire->star_z[i] < 64) {
+            fb_hspan(state, sx, sx + 1, sy); // near stars get a 2 px streak
+        } else if(sx >= 0 && sx < SCREEN_WIDTH && sy >= 0 && sy < SCREEN_HEIGHT) {
+            fb_set_pixel(state, sx, sy);
+        }
+    }
+
+    const int8_t(*vertices)[3] = cube_vertices;
+    const uint8_t(*edges)[2] = cube_edges;
+    uint32_t vertex_count = COUNT_OF(cube_vertices);
+    uint32_t edge_count = COUNT_OF(cube_edges);
+    if(wire->solid == WireSolidOctahedron) {
+        vertices = octahedron_vertices;
+        edges = octahedron_edges;
+        vertex_count = COUNT_OF(octahedron_vertices);
+        edge_count = COUNT_OF(octahedron_edges);
+    }
+
+    // Rotate about Y then X with 6-bit sine table values, then project
+    uint16_t speed = (uint16_t)(state->frequency * 64);
+    wire->angle_x += speed;
+    wire->angle_y += speed + speed / 2;
+    int32_t sin_x = fast_sin(wire->angle_x >> 8);
+    int32_t cos_x = fast_sin((wire->angle_x >> 8) + 16);
+    int32_t sin_y = fast_sin(wire->angle_y >> 8);
+    int32_t cos_y = fast_sin((wire->angle_y >> 8) + 16);
+
+    int16_t screen_x[8];
+    int16_t screen_y[8];
+    for(uint32_t v = 0; v < vertex_count; v++) {
+        int32_t x = vertices[v][0];
+        int32_t y = vertices[v][1];
+        int32_t z = vertices[v][2];
+        int32_t x1 = (x * cos_y - z * sin_y) >> 6;
+        int32_t z1 = (x * sin_y + z * cos_y) >> 6;
+        int32_t y2 = (y * cos_x - z1 * sin_x) >> 6;
+        int32_t z2 = ((y * sin_x + z1 * cos_x) >> 6) + WIRE_CAMERA_Z;
+        uint16_t inv = reciprocal_table[z2];
+        screen_x[v] = SCREEN_WIDTH / 2 + ((x1 * WIRE_FOCAL * inv) >> 16);
+        screen_y[v] = SCREEN_HEIGHT / 2 + ((y2 * WIRE_FOCAL * inv) >> 16);
+    }
+
+    for(uint32_t e = 0; e < edge_count; e++) {
+        uint8_t a = edges[e][0];
+        uint8_t b = edges[e][1];
+        fb_draw_line(state, screen_x[a], screen_y[a], screen_x[b], screen_y[b]);
+    }
+}
+
+static void sdf_init(GenerativeState* state) {
+    SdfState* sdf = &state->sim.sdf;
+    memset(sdf->shade, 0, sizeof(sdf->shade));
+    sdf->cursor = 0;
+    sdf->pass = 0;
+    sdf->scene = state->seed % SdfSceneCount;
+    sdf->angle = 0;
+    sdf->rays = 0;
+    sdf->steps = 0;
+    sdf->images = 0;
+}
+
+// Scene distance in 8.8 fixed point; the object spins with sdf->angle
+static int32_t sdf_distance(SdfState* sdf, int32_t x, int32_t y, int32_t z) {
+    int32_t floor_d = y + 307; // ground plane at y = -1.2
+    int32_t d;
+
+    switch(sdf->scene) {
+        case SdfSceneTorus: {
+            // Spin about Y, tumble about X as well, then torus R = 1.0, r = 0.35
+            int32_t s = fast_sin_fine(sdf->angle);
+            int32_t c = fast_sin_fine(sdf->angle + (16 << 8));
+            int32_t rx = (x * c + z * s) >> 6;
+            int32_t rz = (z * c - x * s) >> 6;
+            int32_t ry = (y * c - rz * s) >> 6;
+            int32_t rz2 = (y * s + rz * c) >> 6;
+            int32_t ring = (int32_t)isqrt32(rx * rx + rz2 * rz2) - 256;
+            d = (int32_t)isqrt32(ring * ring + ry * ry) - 90;
+            break;
+        }
+        case SdfSceneTwist: {
+            // Rotate xz by an angle proportional to height, then a box
+            uint16_t twist = (uint16_t)((y * 12) + sdf->angle);
+            int32_t ts = fast_sin_fine(twist);
+            int32_t tc = fast_sin_fine(twist + (16 << 8));
+            int32_t qx = abs((x * tc + z * ts) >> 6) - 150;
+            int32_t qy = abs(y) - 256;
+            int32_t qz = abs((z * tc - x * ts) >> 6) - 150;
+            int32_t ox = qx > 0 ? qx : 0;
+            int32_t oy = qy > 0 ? qy : 0;
+            int32_t oz = qz > 0 ? qz : 0;
+            int32_t inside = qx > qy ? (qx > qz ? qx : qz) : (qy > qz ? qy : qz);
+            d = (int32_t)isqrt32(ox * ox + oy * oy + oz * oz) + (inside < 0 ? inside : 0);
+            // Twisting stretches space; under-step to stay conservative
+            d = d * 3 / 4;
+            break;
+        }
+        default: {
+            int32_t bob = fast_sin_fine(sdf->angle * 2) * 2;
+            int32_t dy = y - bob;
+            d = (int32_t)isqrt32(x * x + dy * dy + z * z) - 256;
+            break;
+        }
+    }
+    return d < floor_d ? d : floor_d;
+}
+
+// March one 64x32 pixel; returns brightness. The hit threshold grows with
+// distance, so far rays and grazing hits stop early.
+static uint8_t sdf_trace(SdfState* sdf, int32_t px, int32_t py) {
+    // Camera at (0, 0.3, -4) looking down +z, ~90 degree horizontal FOV
+    int32_t dx = (px * 2 - (SDF_W - 1)) * 4;
+    int32_t dy = ((SDF_H - 1) - py * 2) * 4;
+    int32_t dz = 256;
+    int32_t len = isqrt32(dx * dx + dy * dy + dz * dz);
+    dx = dx * 256 / len;
+    dy = dy * 256 / len;
+    dz = dz * 256 / len;
+
+    int32_t t = 0;
+    uint32_t step = 0;
+    for(; step < SDF_MAX_STEPS; step++) {
+        int32_t x = (dx * t) >> 8;
+        int32_t y = 77 + ((dy * t) >> 8);
+        int32_t z = -1024 + ((dz * t) >> 8);
+        int32_t d = sdf_distance(sdf, x, y, z);
+        if(d < 4 + (t >> 6)) break;
+        t += d;
+        if(t > SDF_FAR) break;
+    }
+    sdf->steps += step;
+
+    int32_t sky = 60 + py * 4; // lighter toward the horizon
+    if(t > SDF_FAR || step == SDF_MAX_STEPS) {
+        return sky;
+    }
+
+    // One extra sample toward the light gives the diffuse term (n . L);
+    // the step count doubles as cheap ambient occlusion
+    int32_t x_hit = (dx * t) >> 8;
+    int32_t y_hit = 77 + ((dy * t) >> 8);
+    int32_t z_hit = -1024 + ((dz * t) >> 8);
+    int32_t d_hit = sdf_distance(sdf, x_hit, y_hit, z_hit);
+    int32_t toward = sdf_distance(sdf, x_hit - 8, y_hit + 11, z_hit - 8) - d_hit;
+    int32_t light = 110 + toward * 9 - (int32_t)step * 3;
+    if(y_hit < -290 && (((x_hit >> 8) ^ (z_hit >> 8)) & 1)) {
+        light = light / 2; // checkered floor
+    }
+    light += (sky - light) * (t >> 4) * (t >> 4) / ((SDF_FAR >> 4) * (SDF_FAR >> 4)); // fog
+    return light < 0 ? 0 : light > 255 ? 255 : light;
+}
+
+// 64x32 -> 128x64: even pixels copy, odd ones average their neighbours
+static void sdf_upscale(GenerativeState* state) {
+    SdfState* sdf = &state->sim.sdf;
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        int sy0 = y >> 1;
+        int sy1 = (y & 1) && sy0 < SDF_H - 1 ? sy0 + 1 : sy0;
+        uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+        for(int x = 0; x < SCREEN_WIDTH; x++) {
+            int sx0 = x >> 1;
+            int sx1 = (x & 1) && sx0 < SDF_W - 1 ? sx0 + 1 : sx0;
+            uint32_t sum = sdf->shade[sy0][sx0] + sdf->shade[sy0][sx1] + sdf->shade[sy1][sx0] +
+                           sdf->shade[sy1][sx1];
+            row[x] = state->response_lut[255 - (sum >> 2)]; // ink is the inverse of brightness
+        }
+    }
+    apply_dither(state);
+}
+
+// Trace until the time slice is used up; present each completed pass
+static void sdf_frame(GenerativeState* state) {
+    SdfState* sdf = &state->sim.sdf;
+    uint32_t start = perf_cycles();
+    uint32_t budget = SDF_BUDGET_US * furi_hal_cortex_instructions_per_microsecond();
+    sdf->rays = 0;
+    sdf->steps = 0;
+
+    while(perf_cycles() - start < budget) {
+        if(sdf->pass == 0) {
+            int32_t px = (sdf->cursor % (SDF_W / 2)) * 2;
+            int32_t py = (sdf->cursor / (SDF_W / 2)) * 2;
+            sdf->shade[py][px] = sdf_trace(sdf, px, py);
+            sdf->rays++;
+            if(++sdf->cursor == (SDF_W / 2) * (SDF_H / 2)) {
+                // Show the 32x16 image right away, replicated into 2x2 blocks
+                for(int y = 0; y < SDF_H; y++) {
+                    for(int x = 0; x < SDF_W; x++) {
+                        sdf->shade[y][x] = sdf->shade[y & ~1][x & ~1];
+                    }
+                }
+                sdf_upscale(state);
+                sdf->cursor = 0;
+                sdf->pass = 1;
+            }
+        } else {
+            int32_t px = sdf->cursor % SDF_W;
+            int32_t py = sdf->cursor / SDF_W;
+            if((px | py) & 1) {
+                sdf->shade[py][px] = sdf_trace(sdf, px, py);
+                sdf->rays++;
+            }
+            if(++sdf->cursor == SDF_W * SDF_H) {
+                sdf_upscale(state);
+                sdf->cursor = 0;
+                sdf->pass = 0;
+                sdf->images++;
+                sdf->angle += (uint16_t)(state->frequency * 192);
+            }
+        }
+    }
+}
+
+// Tile atlases, LSB = leftmost pixel like the framebuffer
+static const uint8_t tile_truchet[2][8] = {
+    {0x18, 0x18, 0x0C, 0xC7, 0xE3, 0x30, 0x18, 0x18},
+    {0x18, 0x18, 0x30, 0xE3, 0xC7, 0x0C, 0x18, 0x18},
+};
+static const uint16_t tile_truchet_large[2][16] = {
+    {0x0180, 0x0180, 0x0180, 0x00C0, 0x00E0, 0x0070, 0x0038, 0xE01F,
+     0xF807, 0x1C00, 0x0E00, 0x0700, 0x0300, 0x0180, 0x0180, 0x0180},
+    {0x0180, 0x0180, 0x0180, 0x0300, 0x0700, 0x0E00, 0x1C00, 0xF807,
+     0xE01F, 0x0038, 0x0070, 0x00E0, 0x00C0, 0x0180, 0x0180, 0x0180},
+};
+static const uint8_t tile_10print[2][8] = {
+    {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x80},
+    {0xC0, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01},
+};
+static const uint8_t tile_maze[2][8] = {
+    {0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+};
+static const char* const tile_family_names[TileFamilyCount] = {"Truchet", "Arcs", "10PRINT", "Maze"};
+
+static void tiles_init(GenerativeState* state) {
+    TileState* tiles = &state->sim.tiles;
+    tiles->rng = state->seed;
+    tiles->family = state->seed % TileFamilyCount;
+    tiles->flips = 0;
+    for(int ty = 0; ty < TILE_ROWS; ty++) {
+        tiles->orient[ty] = xorshift32(&tiles->rng);
+    }
+}
+
+// Copy every tile into place: whole-byte stores, no per-pixel work
+static void tiles_blit(GenerativeState* state) {
+    TileState* tiles = &state->sim.tiles;
+    uint8_t* bytes = (uint8_t*)state->fb;
+
+    if(tiles->family == TileFamilyTruchetLarge) {
+        for(int ty = 0; ty < SCREEN_HEIGHT / 16; ty++) {
+            for(int tx = 0; tx < SCREEN_WIDTH / 16; tx++) {
+                const uint16_t* tile = tile_truchet_large[(tiles->orient[ty] >> tx) & 1];
+                uint8_t* dst = &bytes[ty * 16 * FB_ROW_BYTES + tx * 2];
+                for(int r = 0; r < 16; r++) {
+                    dst[0] = tile[r] & 0xFF;
+                    dst[1] = tile[r] >> 8;
+                    dst += FB_ROW_BYTES;
+                }
+            }
+        }
+        return;
+    }
+
+    const uint8_t(*atlas)[8] = tile_truchet;
+    if(tiles->family == TileFamily10Print) atlas = tile_10print;
+    if(tiles->family == TileFamilyMaze) atlas = tile_maze;
+    for(int ty = 0; ty < TILE_ROWS; ty++) {
+        for(int tx = 0; tx < FB_ROW_BYTES; tx++) {
+            const uint8_t* tile = atlas[(tiles->orient[ty] >> tx) & 1];
+            uint8_t* dst = &bytes[ty * 8 * FB_ROW_BYTES + tx];
+            for(int r = 0; r < 8; r++) {
+                dst[r * FB_ROW_BYTES] = tile[r];
+            }
+        }
+    }
+}
+
+static void tiles_frame(GenerativeState* state) {
+    TileState* tiles = &state->sim.tiles;
+    bool large = tiles->family == TileFamilyTruchetLarge;
+    uint32_t rows = large ? SCREEN_HEIGHT / 16 : TILE_ROWS;
+    uint32_t cols = large ? SCREEN_WIDTH / 16 : FB_ROW_BYTES;
+
+    // A few random tiles flip each frame; frequency sets the rate
+    tiles->flips = (uint32_t)(state->frequency * 2);
+    for(uint32_t i = 0; i < tiles->flips; i++) {
+        uint32_t r = xorshift32(&tiles->rng);
+        tiles->orient[(r >> 8) % rows] ^= 1u << (r % cols);
+    }
+
+    tiles_blit(state);
+}
+
+static const LsysSystem lsys_systems[] = {
+    {"Plant", "X", {{'X', "F+[[X]-X]-F[-FX]+X"}, {'F', "FF"}}, "F", 1138, 16 * 256, 5}, // 25 deg
+    {"Dragon", "FX", {{'X', "X+YF+"}, {'Y', "-FX-Y"}}, "F", 16 * 256, 0, 10},
+    {"Koch", "F--F--F", {{'F', "F+F--F+F"}, {0, NULL}}, "F", 2731, 0, 4}, // 60 deg
+    {"Arrow", "A", {{'A', "B-A-B"}, {'B', "A+B+A"}}, "AB", 2731, 0, 6},
+    {"Hilbert", "A", {{'A', "+BF-AFA-FB+"}, {'B', "-AF+BFB+FA-"}}, "F", 16 * 256, 0, 5},
+};
+
+static const char* lsys_rule(const LsysSystem* sys, char symbol) {
+    for(size_t i = 0; i < COUNT_OF(sys->rules); i++) {
+        if(sys->rules[i].symbol == symbol) return sys->rules[i].replace;
+    }
+    return NULL;
+}
+
+static void lsys_start_pass(GenerativeState* state, LsysPass pass) {
+    LsysState* ls = &state->sim.lsys;
+    const LsysSystem* sys = &lsys_systems[ls->system];
+    ls->pass = pass;
+    ls->expand[0].next = sys->axiom;
+    ls->expand[0].depth = 0;
+    ls->expand_sp = 1;
+    ls->chunk_len = 0;
+    ls->chunk_pos = 0;
+    ls->saved_sp = 0;
+    ls->saved_dropped = 0;
+    ls->commands = 0;
+    ls->turtle.heading = sys->heading;
+
+    if(pass == LsysPassMeasure) {
+        ls->step = 1 << 16;
+        ls->turtle.x = 0;
+        ls->turtle.y = 0;
+        ls->min_x = ls->max_x = ls->min_y = ls->max_y = 0;
+        return;
+    }
+
+    // Scale the unit-step bounds to the screen with a 2 pixel margin
+    int32_t w = ls->max_x - ls->min_x;
+    int32_t h = ls->max_y - ls->min_y;
+    if(w < (1 << 16)) w = 1 << 16;
+    if(h < (1 << 16)) h = 1 << 16;
+    int64_t fit_x = ((int64_t)(SCREEN_WIDTH - 5) << 32) / w;
+    int64_t fit_y = ((int64_t)(SCREEN_HEIGHT - 5) << 32) / h;
+    ls->step = (int32_t)(fit_x < fit_y ? fit_x : fit_y);
+    int32_t draw_w = (int32_t)(((int64_t)w * ls->step) >> 16);
+    int32_t draw_h = (int32_t)(((int64_t)h * ls->step) >> 16);
+    ls->turtle.x = (((SCREEN_WIDTH - 1) << 16) - draw_w) / 2 -
+                   (int32_t)(((int64_t)ls->min_x * ls->step) >> 16);
+    ls->turtle.y = (((SCREEN_HEIGHT - 1) << 16) - draw_h) / 2 -
+                   (int32_t)(((int64_t)ls->min_y * ls->step) >> 16);
+    memset(state->fb, 0, sizeof(state->fb));
+}
+
+static void lsys_init(GenerativeState* state) {
+    LsysState* ls = &state->sim.lsys;
+    ls->system = state->seed % COUNT_OF(lsys_systems);
+    ls->next_system = ls->system;
+    ls->depth = LSYS_MIN_DEPTH;
+    ls->segments = 0;
+    lsys_start_pass(state, LsysPassMeasure);
+}
+
+// Refill the command buffer; returns 0 once the whole string has been walked
+static uint8_t lsys_expand(LsysState* ls) {
+    const LsysSystem* sys = &lsys_systems[ls->system];
+    uint8_t n = 0;
+    while(n < LSYS_CHUNK && ls->expand_sp > 0) {
+        LsysFrame* frame = &ls->expand[ls->expand_sp - 1];
+        char c = *frame->next;
+        if(!c) {
+            ls->expand_sp--;
+            continue;
+        }
+        frame->next++;
+        const char* rule = frame->depth < ls->depth ? lsys_rule(sys, c) : NULL;
+        if(rule) {
+            ls->expand[ls->expand_sp].next = rule;
+            ls->expand[ls->expand_sp].depth = frame->depth + 1;
+            ls->expand_sp++;
+        } else {
+            ls->chunk[n++] = c;
+        }
+    }
+    ls->commands += n;
+    return n;
+}
+
+static void lsys_command(GenerativeState* state, char c) {
+    LsysState* ls = &state->sim.lsys;
+    const LsysSystem* sys = &lsys_systems[ls->system];
+    Turtle* t = &ls->turtle;
+
+    // Other letters are variables that only drive the expansion
+    if(strchr(sys->draw, c)) {
+        int32_t x1 = t->x + ((ls->step >> 6) * fast_sin_fine(t->heading + 16 * 256));
+        int32_t y1 = t->y - ((ls->step >> 6) * fast_sin_fine(t->heading));
+        if(ls->pass == LsysPassMeasure) {
+            if(x1 < ls->min_x) ls->min_x = x1;
+            if(x1 > ls->max_x) ls->max_x = x1;
+            if(y1 < ls->min_y) ls->min_y = y1;
+            if(y1 > ls->max_y) ls->max_y = y1;
+        } else {
+            fb_draw_line(
+                state,
+                (t->x + 0x8000) >> 16,
+                (t->y + 0x8000) >> 16,
+                (x1 + 0x8000) >> 16,
+                (y1 + 0x8000) >> 16);
+            ls->segments++;
+        }
+        t->x = x1;
+        t->y = y1;
+        return;
+    }
+
+    switch(c) {
+    case '+':
+        t->heading += sys->angle;
+        break;
+    case '-':
+        t->heading -= sys->angle;
+        break;
+    case '[':
+        if(ls->saved_sp < LSYS_TURTLE_STACK) {
+            ls->saved[ls->saved_sp++] = *t;
+        } else {
+            ls->saved_dropped++;
+        }
+        break;
+    case ']':
+        if(ls->saved_dropped) {
+            ls->saved_dropped--;
+        } else if(ls->saved_sp) {
+            *t = ls->saved[--ls->saved_sp];
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Walk the command stream until the time budget or the segment quota for
+// this tick runs out; the drawing grows across ticks
+static void lsys_frame(GenerativeState* state) {
+    LsysState* ls = &state->sim.lsys;
+    ls->segments = 0;
+
+    if(ls->next_system != ls->system) {
+        ls->system = ls->next_system;
+        ls->depth = LSYS_MIN_DEPTH;
+        lsys_start_pass(state, LsysPassMeasure);
+    }
+
+    if(ls->pass == LsysPassHold) {
+        if(--ls->hold == 0) {
+            // Regrow one generation deeper, then start over
+            ls->depth++;
+            if(ls->depth > lsys_systems[ls->system].max_depth) ls->depth = LSYS_MIN_DEPTH;
+            lsys_start_pass(state, LsysPassMeasure);
+        }
+        return;
+    }
+
+    uint32_t start = perf_cycles();
+    uint32_t budget = LSYS_BUDGET_US * furi_hal_cortex_instructions_per_microsecond();
+    uint32_t quota = (uint32_t)(state->frequency * 64);
+
+    while(ls->segments < quota) {
+        if(ls->chunk_pos == ls->chunk_len) {
+            if(perf_cycles() - start >= budget) break;
+            ls->chunk_len = lsys_expand(ls);
+            ls->chunk_pos = 0;
+            if(ls->chunk_len == 0) {
+                if(ls->pass == LsysPassMeasure) {
+                    lsys_start_pass(state, LsysPassDraw);
+                } else {
+                    ls->pass = LsysPassHold;
+                    ls->hold = LSYS_HOLD_FRAMES;
+                    break;
+                }
+                continue;
+            }
+        }
+        lsys_command(state, ls->chunk[ls->chunk_pos++]);
+    }
+}
+
+// Piecewise-linear curve through (0,0), the measured points and (255,255)
+static void response_lut_build(uint8_t* lut, const uint8_t* level) {
+    int32_t xs[CALIBRATION_POINTS + 2] = {0, 64, 128, 192, 255};
+    int32_t ys[CALIBRATION_POINTS + 2] = {0, level[0], level[1], level[2], 255};
+    for(int seg = 0; seg < CALIBRATION_POINTS + 1; seg++) {
+        int32_t x0 = xs[seg], x1 = xs[seg + 1];
+        for(int32_t i = x0; i <= x1; i++) {
+            lut[i] = ys[seg] + (ys[seg + 1] - ys[seg]) * (i - x0) / (x1 - x0);
+        }
+    }
+}
+
+static bool response_lut_load(GenerativeState* state) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    CalibrationFile data;
+    bool ok = storage_file_open(file, CALIBRATION_PATH, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              storage_file_read(file, &data, sizeof(data)) == sizeof(data) &&
+              data.magic == CALIBRATION_MAGIC && data.version == CALIBRATION_VERSION;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(ok) {
+        memcpy(state->response_lut, data.response, sizeof(state->response_lut));
+        state->response_version++;
+    }
+    return ok;
+}
+
+static bool response_lut_save(GenerativeState* state, const uint8_t* level) {
+    CalibrationFile data = {
+        .magic = CALIBRATION_MAGIC,
+        .version = CALIBRATION_VERSION,
+    };
+    memcpy(data.level, level, sizeof(data.level));
+    memcpy(data.response, state->response_lut, sizeof(data.response));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, CALIBRATION_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+              storage_file_write(file, &data, sizeof(data)) == sizeof(data);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+// Restores the saved parameters; returns true if fb now holds the saved frame
+static bool session_load(GenerativeState* state) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    SessionFile* data = malloc(sizeof(SessionFile));
+    bool ok = storage_file_open(file, SESSION_PATH, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              storage_file_read(file, data, sizeof(SessionFile)) == sizeof(SessionFile) &&
+              data->magic == SESSION_MAGIC && data->version == SESSION_VERSION &&
+              data->mode < GenModeCount;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    // Calibration is a tool, not a picture: come back to the gradient, but
+    // without its test patches on screen
+    bool picture = ok && data->mode != GenModeCalibrate;
+    if(ok) {
+        state->mode = data->mode == GenModeCalibrate ? GenModeGradient : data->mode;
+        state->gradient_type = data->gradient_type % 10;
+        state->curves.type_offset = data->type_offset % 10;
+        state->invert = data->invert;
+        state->half_res_smooth = data->half_res_smooth;
+        state->filter = data->filter % FilterCount;
+        state->morph = data->morph % MorphCount;
+        state->auto_levels = data->auto_levels;
+        state->seed = data->seed;
+        state->frame_count = data->frame_count;
+        state->frequency = data->frequency;
+        state->noise_scale = data->noise_scale;
+        state->curves.frequency_bias = data->frequency_bias;
+    }
+    if(picture) {
+        memcpy(state->fb, data->fb, sizeof(state->fb));
+    }
+    free(data);
+    return picture;
+}
+
+static bool session_save(GenerativeState* state) {
+    SessionFile* data = malloc(sizeof(SessionFile));
+    data->magic = SESSION_MAGIC;
+    data->version = SESSION_VERSION;
+    data->mode = state->active_mode;
+    data->gradient_type = state->gradient_type;
+    data->type_offset = state->curves.type_offset;
+    data->invert = state->invert;
+    data->half_res_smooth = state->half_res_smooth;
+    data->filter = state->filter;
+    data->morph = state->morph;
+    data->auto_levels = state->auto_levels;
+    data->seed = state->seed;
+    data->frame_count = state->frame_count;
+    data->frequency = state->frequency;
+    data->noise_scale = state->noise_scale;
+    data->frequency_bias = state->curves.frequency_bias;
+    // What was on screen, post-dither effects included
+    memcpy(data->fb, state->display, sizeof(data->fb));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, SESSION_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+              storage_file_write(file, data, sizeof(SessionFile)) == sizeof(SessionFile);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(data);
+    return ok;
+}
+
+// Modes whose picture is accumulated state worth keeping; 0 = not saved
+static uint16_t checkpoint_sim_size(uint8_t mode) {
+    switch(mode) {
+        case GenModeSand:
+            return sizeof(SandState);
+        case GenModeDla:
+            return sizeof(DlaState);
+        default:
+            return 0;
+    }
+}
+
+static void checkpoint_abort(CheckpointWriter* cp) {
+    if(cp->file) {
+        storage_file_close(cp->file);
+        storage_file_free(cp->file);
+        cp->file = NULL;
+    }
+    // checkpoint_step closes the file itself once it is complete
+    if(cp->storage) {
+        furi_record_close(RECORD_STORAGE);
+        cp->storage = NULL;
+    }
+    free(cp->blob);
+    cp->blob = NULL;
+}
+
+// Copy the state now so later ticks can write it while the sim runs on
+static bool checkpoint_begin(GenerativeState* state) {
+    CheckpointWriter* cp = &state->checkpoint;
+    uint16_t sim_size = checkpoint_sim_size(state->active_mode);
+    if(!sim_size) return false;
+
+    CheckpointHeader header = {
+        .magic = CHECKPOINT_MAGIC,
+        .version = CHECKPOINT_VERSION,
+        .mode = state->active_mode,
+        .sim_size = sim_size,
+        .seed = state->seed,
+        .frame_count = state->frame_count,
+    };
+    cp->size = sizeof(header) + sizeof(state->fb) + sim_size;
+    cp->blob = malloc(cp->size);
+    memcpy(cp->blob, &header, sizeof(header));
+    memcpy(cp->blob + sizeof(header), state->fb, sizeof(state->fb));
+    memcpy(cp->blob + sizeof(header) + sizeof(state->fb), &state->sim, sim_size);
+    cp->written = 0;
+
+    cp->storage = furi_record_open(RECORD_STORAGE);
+    cp->file = storage_file_alloc(cp->storage);
+    if(!storage_file_open(cp->file, CHECKPOINT_TMP_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        checkpoint_abort(cp);
+        return false;
+    }
+    return true;
+}
+
+// Write the next chunk; returns true once the checkpoint is in place
+static bool checkpoint_step(CheckpointWriter* cp, uint32_t max_bytes) {
+    uint32_t n = cp->size - cp->written;
+    if(n > max_bytes) n = max_bytes;
+    if(storage_file_write(cp->file, cp->blob + cp->written, n) != n) {
+        checkpoint_abort(cp);
+        return false;
+    }
+    cp->written += n;
+    if(cp->written < cp->size) return false;
+
+    storage_file_close(cp->file);
+    storage_file_free(cp->file);
+    cp->file = NULL;
+    storage_simply_remove(cp->storage, CHECKPOINT_PATH);
+    bool ok = storage_common_rename(cp->storage, CHECKPOINT_TMP_PATH, CHECKPOINT_PATH) == FSE_OK;
+    checkpoint_abort(cp);
+    return ok;
+}
+
+// Called once per tick from the timer thread
+static void checkpoint_tick(GenerativeState* state) {
+    CheckpointWriter* cp = &state->checkpoint;
+    if(!cp->blob) {
+        if(state->frame_count < cp->next_frame || !checkpoint_begin(state)) return;
+        cp->next_frame = state->frame_count + CHECKPOINT_INTERVAL_FRAMES;
+    }
+    if(checkpoint_step(cp, CHECKPOINT_CHUNK)) {
+        FURI_LOG_I(TAG, "checkpoint saved, %lu bytes", cp->size);
+    }
+}
+
+// On exit: drop any half-written snapshot and write the current state whole
+static bool checkpoint_save_now(GenerativeState* state) {
+    CheckpointWriter* cp = &state->checkpoint;
+    checkpoint_abort(cp);
+    if(!checkpoint_begin(state)) return false;
+    uint32_t size = cp->size;
+    return checkpoint_step(cp, size);
+}
+
+// Overwrite the freshly initialised mode with the saved state, if the
+// checkpoint belongs to this mode
+static bool checkpoint_resume(GenerativeState* state) {
+    uint16_t sim_size = checkpoint_sim_size(state->active_mode);
+    if(!sim_size) return false;
+
+    uint32_t size = sizeof(CheckpointHeader) + sizeof(state->fb) + sim_size;
+    uint8_t* blob = malloc(size);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, CHECKPOINT_PATH, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              storage_file_read(file, blob, size) == size;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    CheckpointHeader header;
+    memcpy(&header, blob, sizeof(header));
+    ok = ok && header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION &&
+         header.mode == state->active_mode && header.sim_size == sim_size;
+    if(ok) {
+        state->seed = header.seed;
+        // Frame-driven motion (drift, phases, curves) picks up where it was
+        state->frame_count = header.frame_count;
+        state->checkpoint.next_frame = header.frame_count + CHECKPOINT_INTERVAL_FRAMES;
+        memcpy(state->fb, blob + sizeof(header), sizeof(state->fb));
+        memcpy(&state->sim, blob + sizeof(header) + sizeof(state->fb), sim_size);
+    }
+    free(blob);
+    return ok;
+}
+
+static void calibration_init(GenerativeState* state) {
+    CalibrationState* cal = &state->sim.calibration;
+    cal->point = 0;
+    cal->saved = false;
+    for(int i = 0; i < CALIBRATION_POINTS; i++) {
+        cal->level[i] = state->response_lut[(i + 1) * 64];
+    }
+}
+
+// Top: line pattern of known coverage (left) vs. flat dithered level
+// (right). Bottom: a full ramp through the current response curve.
+static void calibration_frame(GenerativeState* state) {
+    CalibrationState* cal = &state->sim.calibration;
+    uint8_t point = cal->point < CALIBRATION_POINTS ? cal->point : CALIBRATION_POINTS - 1;
+    uint8_t level = cal->level[point];
+
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+        if(y < 48) {
+            // (point + 1) of every 4 rows carry ink
+            uint8_t line = (y & 3) <= point ? 255 : 0;
+            memset(row, line, SCREEN_WIDTH / 2);
+            memset(row + SCREEN_WIDTH / 2, level, SCREEN_WIDTH / 2);
+        } else {
+            for(int x = 0; x < SCREEN_WIDTH; x++) {
+                row[x] = state->response_lut[x * 2 + 1];
+            }
+        }
+    }
+    // Always error diffusion: that is what the curve is measured for
+    memset(state->fb, 0, sizeof(state->fb));
+    dither_floyd_steinberg(state, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+// OK in calibration mode: keep this point, and after the last one
+// rebuild the response curve and persist it. Runs on the input thread.
+static void calibration_accept(GenerativeState* state) {
+    CalibrationState* cal = &state->sim.calibration;
+    if(cal->point < CALIBRATION_POINTS - 1) {
+        cal->point++;
+        return;
+    }
+
+    // Keep the curve monotonic so ramps never reverse
+    for(int i = 1; i < CALIBRATION_POINTS; i++) {
+        if(cal->level[i] < cal->level[i - 1]) cal->level[i] = cal->level[i - 1];
+    }
+    response_lut_build(state->response_lut, cal->level);
+    state->response_version++;
+    cal->saved = response_lut_save(state, cal->level);
+    FURI_LOG_I(
+        TAG,
+        "calibration %u/%u/%u %s",
+        cal->level[0],
+        cal->level[1],
+        cal->level[2],
+        cal->saved ? "saved" : "save failed");
+    cal->point = 0;
+}
+
+// Gradient types without hard edges survive 64x32 evaluation unchanged
+static const bool gradient_is_smooth[10] = {
+    true, // horizontal
+    true, // vertical
+    true, // radial
+    true, // diagonal
+    true, // sine
+    true, // cosine
+    true, // interference
+    false, // checkerboard
+    false, // noise
+    false, // spiral (angle seam)
+};
+
+static void
+    gradient_sample_row(GenerativeState* state, const GradientParams* params, int y, uint8_t* out) {
+    for(int k = 0; k < HALF_W; k++) {
+        out[k] = gradient_eval(params, state->tone_lut, k * 2, y, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    out[HALF_W] = out[HALF_W - 1]; // right edge clamps
+}
+
+// Evaluate the field at 64x32 and upsample while streaming rows: two
+// sample rows are live at a time and the in-between pixels are averages
+static void generate_gradient_half_res(GenerativeState* state, const GradientParams* params) {
+    uint8_t rows[2][HALF_W + 1];
+    uint8_t* top = rows[0];
+    uint8_t* bottom = rows[1];
+
+    gradient_sample_row(state, params, 0, top);
+    for(int j = 0; j < HALF_H; j++) {
+        if(j + 1 < HALF_H) {
+            gradient_sample_row(state, params, (j + 1) * 2, bottom);
+        } else {
+            memcpy(bottom, top, HALF_W + 1); // bottom edge clamps
+        }
+        uint8_t* even = &state->pixels[j * 2 * SCREEN_WIDTH];
+        uint8_t* odd = even + SCREEN_WIDTH;
+        for(int k = 0; k < HALF_W; k++) {
+            uint32_t a = top[k];
+            uint32_t b = top[k + 1];
+            uint32_t c = bottom[k];
+            uint32_t d = bottom[k + 1];
+            even[k * 2] = a;
+            even[k * 2 + 1] = (a + b + 1) >> 1;
+            odd[k * 2] = (a + c + 1) >> 1;
+            odd[k * 2 + 1] = (a + b + c + d + 2) >> 2;
+        }
+        uint8_t* t = top;
+        top = bottom;
+        bottom = t;
+    }
+
+    // On frames that log, re-evaluate one row exactly so the log can report
+    // the upsampling error; the other frames keep the whole saving
+    if((state->frame_count + 1) % PERF_LOG_INTERVAL != 0) return;
+    GradientParams exact = *params;
+    exact.histogram = NULL;
+    int y = (state->frame_count / PERF_LOG_INTERVAL) % SCREEN_HEIGHT;
+    const uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+    for(int x = 0; x < SCREEN_WIDTH; x++) {
+        int level = gradient_eval(&exact, state->tone_lut, x, y, SCREEN_WIDTH, SCREEN_HEIGHT);
+        int diff = abs((int)row[x] - level);
+        state->half_res_err_sum += diff;
+        if(diff > state->half_res_err_max) state->half_res_err_max = diff;
+    }
+    state->half_res_err_count += SCREEN_WIDTH;
+}
+
+static bool gradient_uses_half_res(GenerativeState* state) {
+    return state->quality == QualityHalfRes ||
+           (state->half_res_smooth && gradient_is_smooth[state->gradient_type % 10]);
+}
+
+// Black and white points from this frame's histogram, eased towards so a
+// parameter jump fades in; the tone LUT picks them up on the next frame
+static void levels_update(GenerativeState* state) {
+    uint32_t total = 0;
+    for(int i = 0; i < 256; i++) {
+        total += state->histogram[i];
+    }
+    if(!total) return;
+
+    uint32_t clip = total >> LEVELS_CLIP_SHIFT;
+    uint32_t sum = 0;
+    int32_t black = 0;
+    while(black < 255 && (sum += state->histogram[black]) <= clip) black++;
+    sum = 0;
+    int32_t white = 255;
+    while(white > 0 && (sum += state->histogram[white]) <= clip) white--;
+    if(white - black < LEVELS_MIN_SPAN) {
+        black = (black + white - LEVELS_MIN_SPAN) / 2;
+        if(black < 0) black = 0;
+        if(black > 255 - LEVELS_MIN_SPAN) black = 255 - LEVELS_MIN_SPAN;
+        white = black + LEVELS_MIN_SPAN;
+    }
+
+    state->levels_black += ((black << 8) - (int32_t)state->levels_black) >> LEVELS_SMOOTH_SHIFT;
+    state->levels_white += ((white << 8) - (int32_t)state->levels_white) >> LEVELS_SMOOTH_SHIFT;
+    memset(state->histogram, 0, sizeof(state->histogram));
+}
+
+static void generate_gradient_frame(GenerativeState* state) {
+    tone_lut_update(state);
+
+    GradientParams params = {
+        .gradient_type = state->gradient_type,
+        .frequency = state->frequency,
+        .noise_scale = state->noise_scale,
+        .seed = state->seed,
+        .histogram = state->auto_levels ? state->histogram : NULL,
+    };
+    if(gradient_uses_half_res(state)) {
+        generate_gradient_half_res(state, &params);
+    } else {
+        for(int y = 0; y < SCREEN_HEIGHT; y++) {
+            for(int x = 0; x < SCREEN_WIDTH; x++) {
+                state->pixels[y * SCREEN_WIDTH + x] =
+                    gradient_eval(&params, state->tone_lut, x, y, SCREEN_WIDTH, SCREEN_HEIGHT);
+            }
+        }
+    }
+    if(state->auto_levels) {
+        levels_update(state);
+    }
+
+    apply_dither(state);
+}
+
+// Lowest tier a mode can drop to. Only gradient and Worley generate at
+// 64x32; for the others a half-res tier would cost the same as Ord.
+static QualityTier mode_max_quality(uint8_t mode) {
+    switch(mode) {
+        case GenModeGradient:
+        case GenModeWorley:
+            return QualityHalfRes;
+        case GenModeSdf:
+        case GenModeSplit:
+        case GenModeImage:
+            return QualityOrdered;
+        default:
+            return QualityFloydSteinberg;
+    }
+}
+
+static bool mode_has_quality_tiers(uint8_t mode) {
+    return mode_max_quality(mode) != QualityFloydSteinberg;
+}
+
+// Step the tier down quickly when over budget, up slowly when well under
+static void quality_update(GenerativeState* state) {
+    if(state->frame_us > QUALITY_DOWN_US) {
+        state->quality_under = 0;
+        if(++state->quality_over >= QUALITY_DOWN_FRAMES &&
+           state->quality < mode_max_quality(state->active_mode)) {
+            state->quality++;
+            state->quality_over = 0;
+            FURI_LOG_I(
+                TAG, "quality -> %s (%luus)", quality_names[state->quality], state->frame_us);
+        }
+    } else if(state->frame_us < QUALITY_UP_US) {
+        state->quality_over = 0;
+        if(++state->quality_under >= QUALITY_UP_FRAMES && state->quality > QualityFloydSteinberg) {
+            state->quality--;
+            state->quality_under = 0;
+            FURI_LOG_I(
+                TAG, "quality -> %s (%luus)", quality_names[state->quality], state->frame_us);
+        }
+    } else {
+        state->quality_over = 0;
+        state->quality_under = 0;
+    }
+}
+
+_Static_assert(COUNT_OF(evolve_fade) == 1 << EVOLVE_SPAN_SHIFT, "regenerate lut_tables.h");
+
+// The discrete parameters keep the old odds per ~2 s step: a new gradient
+// type 20% of the time, an invert toggle 10% of the time
+static void param_curves_build(ParamCurves* curves, uint32_t seed) {
+    uint32_t rng = seed ? seed : 1;
+    uint8_t type = seed % 10;
+    bool invert = false;
+    for(int i = 0; i < EVOLVE_KNOTS; i++) {
+        curves->frequency[i] = xorshift32(&rng);
+        curves->noise[i] = xorshift32(&rng);
+        if(xorshift32(&rng) % 100 < 20) type = xorshift32(&rng) % 10;
+        if(xorshift32(&rng) % 100 < 10) invert = !invert;
+        curves->gradient_type[i] = type;
+        curves->invert[i] = invert;
+    }
+    curves->seed = seed;
+    curves->valid = true;
+}
+
+static uint8_t param_curve_at(const uint8_t* knots, uint32_t knot, uint32_t phase) {
+    int32_t k0 = knots[knot % EVOLVE_KNOTS];
+    int32_t k1 = knots[(knot + 1) % EVOLVE_KNOTS];
+    return k0 + (((k1 - k0) * evolve_fade[phase]) >> 8);
+}
+
+// Parameters at any frame, past or future, from table lookups only
+static void param_sample(const ParamCurves* curves, uint32_t frame, ParamSample* out) {
+    uint32_t knot = frame >> EVOLVE_SPAN_SHIFT;
+    uint32_t phase = frame & ((1 << EVOLVE_SPAN_SHIFT) - 1);
+    out->frequency = 0.5f + param_curve_at(curves->frequency, knot, phase) * (2.0f / 255.0f);
+    out->noise_scale = param_curve_at(curves->noise, knot, phase) * (0.05f / 256.0f);
+    out->gradient_type = curves->gradient_type[knot % EVOLVE_KNOTS];
+    out->invert = curves->invert[knot % EVOLVE_KNOTS];
+}
+
+static void split_init(GenerativeState* state) {
+    SplitState* split = &state->sim.split;
+    split->viewports = SPLIT_MAX_VIEWPORTS;
+    for(int i = 0; i < SPLIT_MAX_VIEWPORTS; i++) {
+        param_curves_build(&split->curves[i], state->seed ^ ((i + 1) * 0x9E3779B9));
+        // Spread the starting types so neighbours rarely match
+        split->curves[i].type_offset = i * 3;
+        split->curves[i].frequency_bias = 0.0f;
+        split->viewport_us[i] = 0;
+    }
+}
+
+// Both layouts split at x = 64, so every viewport owns whole fb words
+static void split_viewport(uint8_t count, uint8_t i, int* x0, int* y0, int* w, int* h) {
+    *w = SCREEN_WIDTH / 2;
+    *x0 = (i & 1) * *w;
+    *h = count == 2 ? SCREEN_HEIGHT : SCREEN_HEIGHT / 2;
+    *y0 = (i >> 1) * *h;
+}
+
+// Each viewport writes only its own rows of state->pixels and is dithered
+// on its own, so the total work is one screen's worth of pixels
+static void split_frame(GenerativeState* state) {
+    SplitState* split = &state->sim.split;
+    uint8_t count = split->viewports;
+    tone_lut_update(state);
+
+    for(uint8_t i = 0; i < count; i++) {
+        uint32_t start = perf_cycles();
+        int x0, y0, w, h;
+        split_viewport(count, i, &x0, &y0, &w, &h);
+
+        ParamSample sample;
+        param_sample(&split->curves[i], state->frame_count, &sample);
+        GradientParams params = {
+            .gradient_type = (sample.gradient_type + split->curves[i].type_offset) % 10,
+            .frequency = sample.frequency,
+            .noise_scale = sample.noise_scale,
+            .seed = split->curves[i].seed,
+        };
+        split->types[i] = params.gradient_type;
+        // Each viewport follows its own invert, not the shared one
+        const uint8_t* lut = sample.invert != state->invert ? state->tone_lut_flipped :
+                                                               state->tone_lut;
+
+        for(int y = 0; y < h; y++) {
+            uint8_t* row = &state->pixels[(y0 + y) * SCREEN_WIDTH + x0];
+            for(int x = 0; x < w; x++) {
+                row[x] = gradient_eval(&params, lut, x, y, w, h);
+            }
+        }
+        apply_dither_region(state, x0, y0, w, h);
+        split->viewport_us[i] = perf_elapsed_us(start);
+    }
+}
+
+// Types whose level sweeps through many values, so cycling shows movement
+static const uint8_t cycle_gradient_types[] = {2, 3, 6, 9}; // radial, diagonal, interference, spiral
+static const char* const cycle_style_names[CycleStyleCount] = {"Rotate", "Pulse", "Sweep"};
+
+static void cycle_init(GenerativeState* state) {
+    CycleState* cycle = &state->sim.cycle;
+    uint32_t start = perf_cycles();
+    cycle->phase = 0;
+    cycle->style = state->seed % CycleStyleCount;
+    cycle->gradient_type = cycle_gradient_types[(state->seed >> 4) % COUNT_OF(cycle_gradient_types)];
+
+    // Identity mapping: the cache holds the raw field
+    for(int i = 0; i < 256; i++) {
+        cycle->lut[i] = i;
+    }
+    GradientParams params = {
+        .gradient_type = cycle->gradient_type,
+        .frequency = 1.0f + (state->seed >> 8) % 3,
+        .noise_scale = 0.0f,
+        .seed = state->seed,
+    };
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        for(int x = 0; x < SCREEN_WIDTH; x++) {
+            cycle->field[y * SCREEN_WIDTH + x] =
+                gradient_eval(&params, cycle->lut, x, y, SCREEN_WIDTH, SCREEN_HEIGHT);
+        }
+    }
+    cycle->build_us = perf_elapsed_us(start);
+}
+
+static void cycle_lut_build(GenerativeState* state, uint8_t* lut, uint8_t style, uint16_t phase) {
+    uint8_t p = phase >> 8;
+    for(int i = 0; i < 256; i++) {
+        uint8_t v = (uint8_t)(i * 2 + p); // two bands across the level range
+        uint8_t ink;
+        switch(style) {
+            case CycleStylePulse:
+                ink = v < 128 ? v * 2 : (255 - v) * 2;
+                break;
+            case CycleStyleSweep: {
+                // 32-level soft edge just below the moving threshold
+                int32_t d = (int32_t)p - i;
+                ink = d <= 0 ? 0 : d >= 32 ? 255 : d * 8;
+                break;
+            }
+            default:
+                ink = v;
+                break;
+        }
+        lut[i] = state->response_lut[ink];
+    }
+}
 
-typedef struct {
-    Gui* gui;
-    ViewPort* view_port;
-    FuriTimer* timer;
-    GenerativeState* state;
-    NotificationApp* notifications;
-    FuriMessageQueue* event_queue;
-    bool running;
-} FlipperGenApp;
+// Ordered dither of a cached 8-bit field read through a LUT
+static void cycle_dither(GenerativeState* state, const uint8_t* field, const uint8_t* lut) {
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        const uint8_t* threshold = bayer8[y & 7];
+        const uint8_t* row = &field[y * SCREEN_WIDTH];
+        for(int w = 0; w < FB_WORDS; w++) {
+            uint32_t bits = 0;
+            for(int b = 0; b < 32; b++) {
+                if(lut[row[w * 32 + b]] > threshold[b & 7]) bits |= 1u << b;
+            }
+            state->fb[y][w] = bits;
+        }
+    }
+}
 
-// Lightweight pseudo-random number generator
-static uint32_t xorshift32(uint32_t* state) {
-    if(*state == 0) *state = 1; // Prevent zero-lock
-    *state ^= *state << 13;
-    *state ^= *state >> 17;
-    *state ^= *state << 5;
-    return *state;
+// Per frame: 256 LUT entries plus an ordered dither that reads the cached
+// field through the LUT, so no gradient is evaluated
+static void cycle_frame(GenerativeState* state) {
+    CycleState* cycle = &state->sim.cycle;
+    cycle->phase += (uint16_t)(state->frequency * 512);
+    cycle_lut_build(state, cycle->lut, cycle->style, cycle->phase);
+    cycle_dither(state, cycle->field, cycle->lut);
 }
 
-// Fast sine approximation using lookup table
-static const int8_t sine_table[64] = {
-    0, 6, 12, 18, 24, 30, 36, 41, 46, 50, 54, 57, 60, 62, 63, 64,
-    63, 62, 60, 57, 54, 50, 46, 41, 36, 30, 24, 18, 12, 6, 0, -6,
-    -12, -18, -24, -30, -36, -41, -46, -50, -54, -57, -60, -62, -63, -64,
-    -63, -62, -60, -57, -54, -50, -46, -41, -36, -30, -24, -18, -12, -6, 0, 0, 0, 0
-};
+static const char* const image_style_names[ImageStyleCount] = {"Still", "Warp", "Blend", "Cycle"};
 
-static int8_t fast_sin(uint8_t angle) {
-    return sine_table[angle & 63];
+static void image_close(ImageState* img) {
+    if(img->file) {
+        storage_file_close(img->file);
+        storage_file_free(img->file);
+        furi_record_close(RECORD_STORAGE);
+        img->file = NULL;
+    }
+}
+
+// Buffered byte reader; -1 at end of file
+static int image_byte(ImageState* img) {
+    if(img->chunk_pos == img->chunk_len) {
+        img->chunk_len = storage_file_read(img->file, img->chunk, IMAGE_CHUNK);
+        img->chunk_pos = 0;
+        if(!img->chunk_len) return -1;
+    }
+    return img->chunk[img->chunk_pos++];
 }
 
-// Simple Perlin-like noise using bit manipulation
-static uint8_t simple_noise(uint32_t x, uint32_t y, uint32_t seed) {
-    uint32_t hash = (x * 374761393) + (y * 668265263) + seed;
-    hash = (hash ^ (hash >> 13)) * 1274126177;
-    return (hash ^ (hash >> 16)) & 0xFF;
+// Header field: skips whitespace and # comments; 0 on a malformed number
+static uint32_t image_header_number(ImageState* img) {
+    int c = image_byte(img);
+    while(c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        if(c == '#') {
+            while(c >= 0 && c != '\n') c = image_byte(img);
+        }
+        c = image_byte(img);
+    }
+    uint32_t v = 0;
+    while(c >= '0' && c <= '9' && v <= IMAGE_MAX_SIDE) {
+        v = v * 10 + (c - '0');
+        c = image_byte(img);
+    }
+    // The single whitespace after the last field is consumed here too
+    return c >= 0 ? v : 0;
 }
 
-// Gradient generators
-static uint8_t generate_gradient(uint8_t x, uint8_t y, GenerativeState* state) {
-    float nx = (float)x / SCREEN_WIDTH;
-    float ny = (float)y / SCREEN_HEIGHT;
-    float value = 0.0f;
-    
-    switch(state->gradient_type) {
-        case 0: // horizontal
-            value = nx;
-            break;
-        case 1: // vertical
-            value = ny;
+static bool image_open(ImageState* img, const char* path, bool bitmap) {
+    img->storage = furi_record_open(RECORD_STORAGE);
+    img->file = storage_file_alloc(img->storage);
+    if(!storage_file_open(img->file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        image_close(img);
+        return false;
+    }
+    img->bitmap = bitmap;
+    return true;
+}
+
+static void image_init(GenerativeState* state) {
+    ImageState* img = &state->sim.image;
+    memset(img, 0, sizeof(*img));
+    img->style = state->seed % ImageStyleCount;
+    if(!image_open(img, IMAGE_PGM_PATH, false) && !image_open(img, IMAGE_PBM_PATH, true)) {
+        img->status = ImageMissing;
+        return;
+    }
+
+    uint32_t start = perf_cycles();
+    bool ok = image_byte(img) == 'P' && image_byte(img) == (img->bitmap ? '4' : '5');
+    if(ok) {
+        img->src_w = image_header_number(img);
+        img->src_h = image_header_number(img);
+        img->maxval = img->bitmap ? 1 : image_header_number(img);
+        ok = img->src_w && img->src_h && img->src_w <= IMAGE_MAX_SIDE &&
+             img->src_h <= IMAGE_MAX_SIDE && img->maxval && img->maxval <= 255;
+    }
+    img->status = ok ? ImageLoading : ImageInvalid;
+    if(!ok) {
+        image_close(img);
+        FURI_LOG_W(TAG, "image: not a binary PGM/PBM with 8-bit samples");
+    }
+    img->load_us = perf_elapsed_us(start);
+}
+
+// Write the averaged column sums to output rows dst_y..end-1. Upscaled
+// images have output columns (and rows) with no source samples of their
+// own; they repeat the previous one.
+static void image_emit_rows(ImageState* img, uint32_t end) {
+    uint8_t* out = &img->field[img->dst_y * SCREEN_WIDTH];
+    uint8_t last = 0;
+    for(uint32_t x = 0; x < SCREEN_WIDTH; x++) {
+        // Source columns sx with sx * 128 / src_w == x
+        uint32_t lo = (x * img->src_w + SCREEN_WIDTH - 1) / SCREEN_WIDTH;
+        uint32_t hi = ((x + 1) * img->src_w + SCREEN_WIDTH - 1) / SCREEN_WIDTH;
+        if(hi > lo) {
+            last = img->colsum[x] / ((hi - lo) * img->rows_summed);
+        }
+        out[x] = last;
+    }
+    for(uint32_t y = img->dst_y + 1; y < end; y++) {
+        memcpy(&img->field[y * SCREEN_WIDTH], out, SCREEN_WIDTH);
+    }
+    img->dst_y = end;
+    memset(img->colsum, 0, sizeof(img->colsum));
+    img->rows_summed = 0;
+}
+
+// Decode and accumulate one source row; false on a truncated file
+static bool image_decode_row(ImageState* img) {
+    uint32_t x_acc = 0; // sx * 128, compared against src_w to find the output column
+    uint32_t x = 0;
+    if(img->bitmap) {
+        for(uint32_t sx = 0; sx < img->src_w; sx += 8) {
+            int c = image_byte(img);
+            if(c < 0) return false;
+            for(uint32_t b = 0; b < 8 && sx + b < img->src_w; b++) {
+                if(c & (0x80 >> b)) img->colsum[x] += 255;
+                x_acc += SCREEN_WIDTH;
+                while(x_acc >= img->src_w) {
+                    x_acc -= img->src_w;
+                    x++;
+                }
+            }
+        }
+    } else {
+        for(uint32_t sx = 0; sx < img->src_w; sx++) {
+            int c = image_byte(img);
+            if(c < 0) return false;
+            // PGM stores brightness, the field stores ink
+            img->colsum[x] += 255 - (c > img->maxval ? 255 : c * 255 / img->maxval);
+            x_acc += SCREEN_WIDTH;
+            while(x_acc >= img->src_w) {
+                x_acc -= img->src_w;
+                x++;
+            }
+        }
+    }
+    img->rows_summed++;
+    img->src_y++;
+
+    // Flush once the next source row belongs to a later output row
+    uint32_t end = img->src_y * SCREEN_HEIGHT / img->src_h;
+    if(end > img->dst_y) image_emit_rows(img, end);
+    return true;
+}
+
+static void image_load_step(GenerativeState* state) {
+    ImageState* img = &state->sim.image;
+    uint32_t start = perf_cycles();
+    while(img->src_y < img->src_h && perf_elapsed_us(start) < IMAGE_BUDGET_US) {
+        if(!image_decode_row(img)) {
+            img->status = ImageInvalid;
+            FURI_LOG_W(TAG, "image: truncated at row %u", img->src_y);
             break;
-        case 2: // radial
-            {
-                float dx = nx - 0.5f;
-                float dy = ny - 0.5f;
-                value = sqrtf(dx*dx + dy*dy) * 1.414f; // normalize
+        }
+    }
+    img->load_us += perf_elapsed_us(start);
+    if(img->src_y == img->src_h) {
+        img->status = ImageReady;
+        FURI_LOG_I(
+            TAG, "image %ux%u decoded in %luus", img->src_w, img->src_h, img->load_us);
+    }
+    if(img->status != ImageLoading) image_close(img);
+}
+
+static void image_frame(GenerativeState* state) {
+    ImageState* img = &state->sim.image;
+    if(img->status == ImageLoading) {
+        image_load_step(state);
+    }
+    if(img->status == ImageMissing || img->status == ImageInvalid) {
+        memset(state->fb, 0, sizeof(state->fb));
+        return;
+    }
+
+    // Rows below dst_y are still blank while loading, so the picture fills
+    // in from the top
+    img->phase += (uint16_t)(state->frequency * 512);
+    if(img->style == ImageStyleCycle) {
+        cycle_lut_build(state, img->lut, CycleStylePulse, img->phase);
+        cycle_dither(state, img->field, img->lut);
+        return;
+    }
+
+    tone_lut_update(state);
+    GradientParams params = {
+        .gradient_type = state->gradient_type,
+        .frequency = state->frequency,
+        .noise_scale = 0.0f,
+        .seed = state->seed,
+    };
+    // Crossfade weight for the blend, 0..256
+    int32_t mix = 128 + fast_sin_fine(img->phase >> 2) * 2;
+    uint8_t p = img->phase >> 8;
+    for(int y = 0; y < SCREEN_HEIGHT; y++) {
+        uint8_t* row = &state->pixels[y * SCREEN_WIDTH];
+        const uint8_t* src = &img->field[y * SCREEN_WIDTH];
+        switch(img->style) {
+            case ImageStyleWarp: {
+                // Rows slide sideways, columns bob up and down, 4 px at most
+                int32_t dx = fast_sin(y + p) >> 4;
+                for(int x = 0; x < SCREEN_WIDTH; x++) {
+                    int32_t sx = (x + dx) & (SCREEN_WIDTH - 1);
+                    int32_t sy = (y + (fast_sin(x / 2 + p) >> 4)) & (SCREEN_HEIGHT - 1);
+                    row[x] = state->tone_lut[img->field[sy * SCREEN_WIDTH + sx]];
+                }
+                break;
             }
+            case ImageStyleBlend:
+                for(int x = 0; x < SCREEN_WIDTH; x++) {
+                    int32_t g =
+                        gradient_eval(&params, state->tone_lut, x, y, SCREEN_WIDTH, SCREEN_HEIGHT);
+                    row[x] = (state->tone_lut[src[x]] * mix + g * (256 - mix)) >> 8;
+                }
+                break;
+            default:
+                for(int x = 0; x < SCREEN_WIDTH; x++) {
+                    row[x] = state->tone_lut[src[x]];
+                }
+                break;
+        }
+    }
+    apply_dither(state);
+}
+
+// (Re)initialise the simulation for the current mode
+static void mode_enter(GenerativeState* state) {
+    // Reseeds within a mode (e.g. DLA regrowth) keep the checkpoint schedule
+    if(state->active_mode != state->mode) {
+        state->checkpoint.next_frame = state->frame_count + CHECKPOINT_INTERVAL_FRAMES;
+    }
+    // The image decoder may still hold its file open
+    if(state->active_mode == GenModeImage) {
+        image_close(&state->sim.image);
+    }
+    memset(state->fb, 0, sizeof(state->fb));
+    switch(state->mode) {
+        case GenModeFlowField:
+            flow_field_init(state);
             break;
-        case 3: // diagonal
-            value = (nx + ny) / 2.0f;
+        case GenModeBoids:
+            boids_init(state);
             break;
-        case 4: // sine wave
-            value = (fast_sin((uint8_t)(nx * 64 * state->frequency)) + 64) / 128.0f;
+        case GenModeSand:
+            sand_init(state);
             break;
-        case 5: // cosine wave
-            value = (fast_sin((uint8_t)(ny * 64 * state->frequency + 16)) + 64) / 128.0f;
+        case GenModeWorley:
+            worley_init(state);
             break;
-        case 6: // interference
-            {
-                int8_t wave1 = fast_sin((uint8_t)(nx * 32 * state->frequency));
-                int8_t wave2 = fast_sin((uint8_t)(ny * 32 * state->frequency));
-                value = ((wave1 * wave2) / 64 + 64) / 128.0f;
-            }
+        case GenModeDla:
+            dla_init(state);
             break;
-        case 7: // checkerboard
-            {
-                uint8_t check_x = (uint8_t)(nx * 8 * state->frequency) & 1;
-                uint8_t check_y = (uint8_t)(ny * 8 * state->frequency) & 1;
-                value = (check_x ^ check_y) ? 1.0f : 0.0f;
-            }
+        case GenModeWireframe:
+            wireframe_init(state);
             break;
-        case 8: // noise
-            value = simple_noise(x, y, state->seed) / 255.0f;
+        case GenModeSdf:
+            sdf_init(state);
             break;
-        case 9: // spiral
-            {
-                float dx = nx - 0.5f;
-                float dy = ny - 0.5f;
-                float angle = atan2f(dy, dx);
-                float dist = sqrtf(dx*dx + dy*dy);
-                value = fmodf((angle + dist * 10.0f), 6.28f) / 6.28f;
-            }
+        case GenModeTiles:
+            tiles_init(state);
+            break;
+        case GenModeLsystem:
+            lsys_init(state);
+            break;
+        case GenModeSplit:
+            split_init(state);
+            break;
+        case GenModeCycle:
+            cycle_init(state);
+            break;
+        case GenModeImage:
+            image_init(state);
+            break;
+        case GenModeCalibrate:
+            calibration_init(state);
             break;
         default:
-            value = nx;
+            break;
     }
-    
-    // Apply noise overlay
-    if(state->noise_scale > 0) {
-        float noise = simple_noise(
-            (uint32_t)(x * state->noise_scale),
-            (uint32_t)(y * state->noise_scale),
-            state->seed
-        ) / 255.0f;
-        value = value * 0.7f + noise * 0.3f;
+    state->active_mode = state->mode;
+    state->reset_requested = false;
+    // The tier carries over between modes, within what the new one has
+    if(state->quality > mode_max_quality(state->active_mode)) {
+        state->quality = mode_max_quality(state->active_mode);
+    }
+    state->quality_over = 0;
+    state->quality_under = 0;
+
+    if(state->checkpoint.resume_pending) {
+        state->checkpoint.resume_pending = false;
+        uint32_t start = perf_cycles();
+        if(checkpoint_resume(state)) {
+            FURI_LOG_I(TAG, "resumed from checkpoint in %luus", perf_elapsed_us(start));
+        }
     }
-    
-    // Clamp and invert if needed
-    if(value < 0) value = 0;
-    if(value > 1) value = 1;
-    if(state->invert) value = 1.0f - value;
-    
-    return (uint8_t)(value * 255);
 }
 
-// Floyd-Steinberg dithering
-static void apply_dither(GenerativeState* state) {
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        for(int x = 0; x < SCREEN_WIDTH; x++) {
-            int idx = y * SCREEN_WIDTH + x;
-            uint8_t old_pixel = state->pixels[idx];
-            uint8_t new_pixel = old_pixel > 127 ? 255 : 0;
-            state->pixels[idx] = new_pixel;
-            
-            int error = old_pixel - new_pixel;
-            
-            // Distribute error to neighbors
-            if(x + 1 < SCREEN_WIDTH) {
-                int right_idx = y * SCREEN_WIDTH + (x + 1);
-                int new_val = state->pixels[right_idx] + (error * 7) / 16;
-                state->pixels[right_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
-            }
-            
-            if(y + 1 < SCREEN_HEIGHT) {
-                if(x > 0) {
-                    int bl_idx = (y + 1) * SCREEN_WIDTH + (x - 1);
-                    int new_val = state->pixels[bl_idx] + (error * 3) / 16;
-                    state->pixels[bl_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
-                }
-                
-                int bottom_idx = (y + 1) * SCREEN_WIDTH + x;
-                int new_val = state->pixels[bottom_idx] + (error * 5) / 16;
-                state->pixels[bottom_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
-                
-                if(x + 1 < SCREEN_WIDTH) {
-                    int br_idx = (y + 1) * SCREEN_WIDTH + (x + 1);
-                    int new_val = state->pixels[br_idx] + (error * 1) / 16;
-                    state->pixels[br_idx] = (new_val < 0) ? 0 : (new_val > 255) ? 255 : new_val;
-                }
+static void log_perf(GenerativeState* state) {
+    switch(state->active_mode) {
+        case GenModeFlowField:
+            // Particles that would fit in the 33 ms frame budget at this cost
+            FURI_LOG_I(
+                TAG,
+                "flow: %d particles/frame in %luus (capacity ~%lu/frame @30fps)",
+                FLOW_PARTICLES,
+                state->frame_us,
+                state->frame_us ? (uint32_t)FLOW_PARTICLES * 33333UL / state->frame_us : 0UL);
+            break;
+        case GenModeBoids:
+            FURI_LOG_I(
+                TAG,
+                "boids: %u boids/frame in %luus (capacity ~%lu/frame @30fps)",
+                state->sim.boids.count,
+                state->frame_us,
+                state->frame_us ? (uint32_t)state->sim.boids.count * 33333UL / state->frame_us :
+                                  0UL);
+            break;
+        case GenModeSand:
+            FURI_LOG_I(
+                TAG,
+                "sand: %u steps/frame in %luus (%luus/step)",
+                state->sim.sand.steps_per_frame,
+                state->frame_us,
+                state->frame_us / state->sim.sand.steps_per_frame);
+            break;
+        case GenModeWorley:
+            FURI_LOG_I(
+                TAG,
+                "worley %u: %d sites, %luus/frame [%s]",
+                state->sim.worley.variant,
+                WORLEY_GRID_W * WORLEY_GRID_H,
+                state->frame_us,
+                quality_names[state->quality]);
+            break;
+        case GenModeDla:
+            FURI_LOG_I(
+                TAG,
+                "dla: %lu stuck, %lu walker steps in %luus",
+                state->sim.dla.stuck,
+                state->sim.dla.steps,
+                state->frame_us);
+            break;
+        case GenModeWireframe:
+            FURI_LOG_I(
+                TAG,
+                "wireframe: %d stars + solid %u, clear+draw %luus",
+                WIRE_STARS,
+                state->sim.wire.solid,
+                state->frame_us);
+            break;
+        case GenModeSdf:
+            FURI_LOG_I(
+                TAG,
+                "sdf %u: %lu rays, %lu steps/ray in %luus, %lu images [%s]",
+                state->sim.sdf.scene,
+                state->sim.sdf.rays,
+                state->sim.sdf.rays ? state->sim.sdf.steps / state->sim.sdf.rays : 0UL,
+                state->frame_us,
+                state->sim.sdf.images,
+                quality_names[state->quality]);
+            break;
+        case GenModeTiles:
+            FURI_LOG_I(
+                TAG,
+                "tiles %s: %lu flips, full blit %luus",
+                tile_family_names[state->sim.tiles.family],
+                state->sim.tiles.flips,
+                state->frame_us);
+            break;
+        case GenModeLsystem:
+            FURI_LOG_I(
+                TAG,
+                "lsys %s depth %u: %lu segments, %lu commands, %luus",
+                lsys_systems[state->sim.lsys.system].name,
+                state->sim.lsys.depth,
+                state->sim.lsys.segments,
+                state->sim.lsys.commands,
+                state->frame_us);
+            break;
+        case GenModeSplit: {
+            const SplitState* split = &state->sim.split;
+            for(uint8_t i = 0; i < split->viewports; i++) {
+                FURI_LOG_I(
+                    TAG,
+                    "split %u/%u: gradient %u, %luus",
+                    i + 1,
+                    split->viewports,
+                    split->types[i],
+                    split->viewport_us[i]);
             }
+            FURI_LOG_I(
+                TAG, "split total: %luus [%s]", state->frame_us, quality_names[state->quality]);
+            break;
         }
+        case GenModeCycle:
+            FURI_LOG_I(
+                TAG,
+                "cycle %s on gradient %u: %luus/frame (field built once in %luus)",
+                cycle_style_names[state->sim.cycle.style],
+                state->sim.cycle.gradient_type,
+                state->frame_us,
+                state->sim.cycle.build_us);
+            break;
+        case GenModeImage:
+            FURI_LOG_I(
+                TAG,
+                "image %s %ux%u: %luus/frame (decode %luus, %u/64 rows)",
+                image_style_names[state->sim.image.style],
+                state->sim.image.src_w,
+                state->sim.image.src_h,
+                state->frame_us,
+                state->sim.image.load_us,
+                state->sim.image.dst_y);
+            break;
+        case GenModeCalibrate:
+            break;
+        default:
+            FURI_LOG_I(
+                TAG,
+                "gradient %d: %luus/frame [%s%s]",
+                state->gradient_type,
+                state->frame_us,
+                quality_names[state->quality],
+                gradient_uses_half_res(state) ? " 64x32" : "");
+            if(state->auto_levels) {
+                FURI_LOG_I(
+                    TAG,
+                    "levels: black %u, white %u",
+                    state->tone_built.black,
+                    state->tone_built.white);
+            }
+            if(state->half_res_err_count) {
+                // Mean absolute error in 1/100 grey levels over the sampled rows
+                FURI_LOG_I(
+                    TAG,
+                    "half-res: mean err %lu.%02lu, max %u",
+                    state->half_res_err_sum / state->half_res_err_count,
+                    state->half_res_err_sum * 100 / state->half_res_err_count % 100,
+                    state->half_res_err_max);
+                state->half_res_err_sum = 0;
+                state->half_res_err_count = 0;
+                state->half_res_err_max = 0;
+            }
+            break;
+    }
+    if(state->filter != FilterNone && state->filter_us) {
+        FURI_LOG_I(TAG, "filter %s: %luus", filter_names[state->filter], state->filter_us);
+    }
+    if(state->morph != MorphNone && state->morph_us) {
+        FURI_LOG_I(TAG, "morph %s: %luus", morph_names[state->morph], state->morph_us);
     }
 }
 
 // Generate new frame
 static void generate_frame(GenerativeState* state) {
-    // Generate gradient
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        for(int x = 0; x < SCREEN_WIDTH; x++) {
-            state->pixels[y * SCREEN_WIDTH + x] = generate_gradient(x, y, state);
-        }
+    if(state->reset_requested || state->active_mode != state->mode) {
+        mode_enter(state);
     }
-    
-    // Apply dithering
-    apply_dither(state);
-    
-    // Evolve parameters for next frame
+
+    uint32_t start = perf_cycles();
+    state->filter_us = 0;
+    switch(state->active_mode) {
+        case GenModeFlowField:
+            flow_field_step(state);
+            break;
+        case GenModeBoids:
+            boids_step(state);
+            break;
+        case GenModeSand:
+            sand_frame(state);
+            break;
+        case GenModeWorley:
+            worley_frame(state);
+            break;
+        case GenModeDla:
+            dla_frame(state);
+            break;
+        case GenModeWireframe:
+            wireframe_frame(state);
+            break;
+        case GenModeSdf:
+            sdf_frame(state);
+            break;
+        case GenModeTiles:
+            tiles_frame(state);
+            break;
+        case GenModeLsystem:
+            lsys_frame(state);
+            break;
+        case GenModeSplit:
+            split_frame(state);
+            break;
+        case GenModeCycle:
+            cycle_frame(state);
+            break;
+        case GenModeImage:
+            image_frame(state);
+            break;
+        case GenModeCalibrate:
+            calibration_frame(state);
+            break;
+        default:
+            generate_gradient_frame(state);
+            break;
+    }
+    morph_apply(state);
+    state->frame_us = perf_elapsed_us(start);
+    if(mode_has_quality_tiers(state->active_mode)) {
+        quality_update(state);
+    }
+
     state->frame_count++;
-    if(state->frame_count % 30 == 0) { // Change every 30 frames (~1 second)
-        uint32_t rng_state = state->seed + state->frame_count;
-        
-        // Sometimes change gradient type
-        if((xorshift32(&rng_state) % 100) < 20) {
-            state->gradient_type = xorshift32(&rng_state) % 10;
-        }
-        
-        // Vary frequency
-        state->frequency = 0.5f + (float)(xorshift32(&rng_state) % 100) / 50.0f;
-        
-        // Vary noise
-        state->noise_scale = (float)(xorshift32(&rng_state) % 50) / 1000.0f;
-        
-        // Sometimes invert
-        if((xorshift32(&rng_state) % 100) < 10) {
-            state->invert = !state->invert;
+    if(state->frame_count % PERF_LOG_INTERVAL == 0) {
+        log_perf(state);
+    }
+    checkpoint_tick(state);
+
+    // Evolve parameters for next frame
+    if(state->active_mode == GenModeGradient) {
+        if(!state->curves.valid || state->curves.seed != state->seed) {
+            param_curves_build(&state->curves, state->seed);
         }
+        ParamSample sample;
+        param_sample(&state->curves, state->frame_count, &sample);
+        state->frequency = fminf(4.0f, fmaxf(0.1f, sample.frequency + state->curves.frequency_bias));
+        state->noise_scale = sample.noise_scale;
+        state->gradient_type = (sample.gradient_type + state->curves.type_offset) % 10;
+        state->invert = sample.invert;
     }
 }
 
@@ -212,19 +3359,136 @@ static void generate_frame(GenerativeState* state) {
 static void draw_callback(Canvas* canvas, void* context) {
     GenerativeState* state = (GenerativeState*)context;
     
-    // Draw pixels
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        for(int x = 0; x < SCREEN_WIDTH; x++) {
-            if(state->pixels[y * SCREEN_WIDTH + x] > 127) {
-                canvas_draw_dot(canvas, x, y);
-            }
-        }
+    // Blit the packed framebuffer in one call
+    canvas_draw_xbm(canvas, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, (const uint8_t*)state->display);
+    if(state->frame_pending) {
+        // Frees the timer to render the next one
+        state->frame_pending = false;
+        state->frames_displayed++;
+    }
+    if(!state->first_draw_done) {
+        state->first_draw_done = true;
+        FURI_LOG_I(
+            TAG,
+            "first draw after %luus (%s)",
+            perf_elapsed_us(state->launch_cycles),
+            state->restored ? "restored frame" : "blank");
     }
     
     // Draw minimal UI
     canvas_set_font(canvas, FontSecondary);
     char info[32];
-    snprintf(info, sizeof(info), "G:%d F:%.1f", state->gradient_type, (double)state->frequency);
+    switch(state->active_mode) {
+        case GenModeFlowField:
+            snprintf(info, sizeof(info), "Flow:%d %luus", FLOW_PARTICLES, state->frame_us);
+            break;
+        case GenModeBoids:
+            snprintf(info, sizeof(info), "Boids:%u %luus", state->sim.boids.count, state->frame_us);
+            break;
+        case GenModeSand:
+            snprintf(
+                info, sizeof(info), "Sand:%ux %luus", state->sim.sand.steps_per_frame, state->frame_us);
+            break;
+        case GenModeWorley:
+            snprintf(
+                info,
+                sizeof(info),
+                "Cells:%u %s %luus",
+                state->sim.worley.variant,
+                quality_names[state->quality],
+                state->frame_us);
+            break;
+        case GenModeDla:
+            snprintf(info, sizeof(info), "DLA:%lu", state->sim.dla.stuck);
+            break;
+        case GenModeWireframe:
+            snprintf(info, sizeof(info), "3D %luus", state->frame_us);
+            break;
+        case GenModeSdf:
+            snprintf(
+                info,
+                sizeof(info),
+                "SDF:%u #%lu %s",
+                state->sim.sdf.scene,
+                state->sim.sdf.images,
+                quality_names[state->quality]);
+            break;
+        case GenModeTiles:
+            snprintf(
+                info,
+                sizeof(info),
+                "%s %luus",
+                tile_family_names[state->sim.tiles.family],
+                state->frame_us);
+            break;
+        case GenModeLsystem:
+            snprintf(
+                info,
+                sizeof(info),
+                "%s d%u %luus",
+                lsys_systems[state->sim.lsys.system].name,
+                state->sim.lsys.depth,
+                state->frame_us);
+            break;
+        case GenModeSplit:
+            snprintf(
+                info, sizeof(info), "Split %u %luus", state->sim.split.viewports, state->frame_us);
+            break;
+        case GenModeCycle:
+            snprintf(
+                info,
+                sizeof(info),
+                "%s %luus",
+                cycle_style_names[state->sim.cycle.style],
+                state->frame_us);
+            break;
+        case GenModeImage: {
+            const ImageState* img = &state->sim.image;
+            if(img->status == ImageMissing) {
+                snprintf(info, sizeof(info), "No image.pgm/pbm");
+            } else if(img->status == ImageInvalid) {
+                snprintf(info, sizeof(info), "Bad image file");
+            } else if(img->status == ImageLoading) {
+                // image_init zeroes the state from the timer thread first
+                uint16_t src_h = img->src_h;
+                snprintf(
+                    info, sizeof(info), "Loading %u%%", src_h ? img->src_y * 100 / src_h : 0);
+            } else {
+                snprintf(
+                    info,
+                    sizeof(info),
+                    "%s %ux%u %luus",
+                    image_style_names[img->style],
+                    img->src_w,
+                    img->src_h,
+                    state->frame_us);
+            }
+            break;
+        }
+        case GenModeCalibrate: {
+            const CalibrationState* cal = &state->sim.calibration;
+            uint8_t point = cal->point < CALIBRATION_POINTS ? cal->point : 0;
+            snprintf(
+                info,
+                sizeof(info),
+                "Cal %d%%: %u%s",
+                (point + 1) * 25,
+                cal->level[point],
+                cal->saved && point == 0 ? " saved" : "");
+            break;
+        }
+        default:
+            snprintf(
+                info,
+                sizeof(info),
+                "G:%d F:%.1f %s%s%s",
+                state->gradient_type,
+                (double)state->frequency,
+                quality_names[state->quality],
+                gradient_uses_half_res(state) ? " h" : "",
+                state->auto_levels ? " A" : "");
+            break;
+    }
     canvas_draw_str(canvas, 1, 8, info);
 }
 
@@ -235,10 +3499,117 @@ static void input_callback(InputEvent* input_event, void* context) {
     furi_message_queue_put(event_queue, input_event, FuriWaitForever);
 }
 
+// Up/Down: per-mode primary parameter
+static void mode_adjust(GenerativeState* state, bool up) {
+    // A newly selected mode isn't entered until the next tick; until then
+    // sim still holds the previous mode's state
+    if(state->active_mode != state->mode) return;
+    switch(state->active_mode) {
+        case GenModeFlowField: {
+            FlowFieldState* flow = &state->sim.flow;
+            if(up && flow->fade < 4) flow->fade++;
+            if(!up && flow->fade > 1) flow->fade--;
+            break;
+        }
+        case GenModeBoids: {
+            // Doubling steps make the linear scaling easy to see in the log
+            BoidsState* boids = &state->sim.boids;
+            if(up && boids->count < BOIDS_MAX) boids->count *= 2;
+            if(!up && boids->count > BOIDS_MIN) boids->count /= 2;
+            break;
+        }
+        case GenModeSand: {
+            SandState* sand = &state->sim.sand;
+            if(up && sand->steps_per_frame < SAND_STEPS_MAX) sand->steps_per_frame++;
+            if(!up && sand->steps_per_frame > 1) sand->steps_per_frame--;
+            break;
+        }
+        case GenModeWorley: {
+            WorleyState* worley = &state->sim.worley;
+            worley->variant = (worley->variant + 1) % WorleyVariantCount;
+            break;
+        }
+        case GenModeWireframe: {
+            WireframeState* wire = &state->sim.wire;
+            wire->solid = (wire->solid + 1) % WireSolidCount;
+            break;
+        }
+        case GenModeSdf: {
+            SdfState* sdf = &state->sim.sdf;
+            sdf->scene = (sdf->scene + (up ? 1 : SdfSceneCount - 1)) % SdfSceneCount;
+            break;
+        }
+        case GenModeTiles: {
+            TileState* tiles = &state->sim.tiles;
+            tiles->family = (tiles->family + (up ? 1 : TileFamilyCount - 1)) % TileFamilyCount;
+            break;
+        }
+        case GenModeLsystem: {
+            // Picked up by the timer thread, which owns the framebuffer
+            LsysState* ls = &state->sim.lsys;
+            uint8_t count = COUNT_OF(lsys_systems);
+            ls->next_system = (ls->next_system + (up ? 1 : count - 1)) % count;
+            break;
+        }
+        case GenModeSplit: {
+            SplitState* split = &state->sim.split;
+            split->viewports = split->viewports == SPLIT_MAX_VIEWPORTS ? 2 : SPLIT_MAX_VIEWPORTS;
+            break;
+        }
+        case GenModeCycle: {
+            CycleState* cycle = &state->sim.cycle;
+            cycle->style = (cycle->style + (up ? 1 : CycleStyleCount - 1)) % CycleStyleCount;
+            break;
+        }
+        case GenModeImage: {
+            ImageState* img = &state->sim.image;
+            img->style = (img->style + (up ? 1 : ImageStyleCount - 1)) % ImageStyleCount;
+            break;
+        }
+        case GenModeCalibrate: {
+            CalibrationState* cal = &state->sim.calibration;
+            uint8_t* level = &cal->level[cal->point];
+            if(up && *level <= 255 - CALIBRATION_STEP) *level += CALIBRATION_STEP;
+            if(!up && *level >= CALIBRATION_STEP) *level -= CALIBRATION_STEP;
+            cal->saved = false;
+            break;
+        }
+        default:
+            state->curves.type_offset = (state->curves.type_offset + (up ? 1 : 9)) % 10;
+            break;
+    }
+}
+
 // Timer callback for animation
 static void timer_callback(void* context) {
     FlipperGenApp* app = (FlipperGenApp*)context;
-    generate_frame(app->state);
+    GenerativeState* state = app->state;
+    if(state->frame_pending) {
+        if(++state->stalled_ticks < FRAME_DEADLINE_TICKS) {
+            state->ticks_skipped++;
+            return;
+        }
+        state->frames_dropped++;
+    }
+    state->stalled_ticks = 0;
+
+    generate_frame(state);
+    state->frames_produced++;
+    if(state->frames_produced % FRAME_STATS_INTERVAL == 0) {
+        FURI_LOG_I(
+            TAG,
+            "frames: %lu produced, %lu displayed, %lu dropped, %lu ticks skipped",
+            state->frames_produced,
+            state->frames_displayed,
+            state->frames_dropped,
+            state->ticks_skipped);
+    }
+    if(!state->first_frame_done) {
+        state->first_frame_done = true;
+        FURI_LOG_I(
+            TAG, "first generated frame after %luus", perf_elapsed_us(state->launch_cycles));
+    }
+    state->frame_pending = true;
     view_port_update(app->view_port);
 }
 
@@ -250,13 +3621,28 @@ FlipperGenApp* flipper_gen_app_alloc() {
     app->state = malloc(sizeof(GenerativeState));
     furi_check(app->state != NULL);
     memset(app->state, 0, sizeof(GenerativeState));
+    app->state->launch_cycles = perf_cycles();
     app->state->seed = furi_get_tick();
     app->state->mode = 0;
     app->state->gradient_type = 0;
     app->state->frequency = 1.0f;
     app->state->noise_scale = 0.05f;
     app->state->invert = false;
+    app->state->gamma = 1.0f;
+    app->state->contrast = 1.0f;
+    app->state->brightness = 0.0f;
+    for(int i = 0; i < 256; i++) {
+        app->state->response_lut[i] = i;
+    }
     app->state->frame_count = 0;
+    app->state->reset_requested = true;
+    app->state->half_res_smooth = true;
+    app->state->auto_levels = true;
+    app->state->levels_white = 255 << 8;
+    app->state->display = app->state->fb;
+    // Only the small session file is read before the first draw
+    app->state->restored = session_load(app->state);
+    app->state->checkpoint.resume_pending = true;
     
     app->gui = furi_record_open(RECORD_GUI);
     app->notifications = furi_record_open(RECORD_NOTIFICATION);
@@ -270,11 +3656,8 @@ FlipperGenApp* flipper_gen_app_alloc() {
     
     gui_add_view_port(app->gui, app->view_port, GuiLayerFullscreen);
     
+    // Started by flipper_gen_app once the first frame is on screen
     app->timer = furi_timer_alloc(timer_callback, FuriTimerTypePeriodic, app);
-    furi_timer_start(app->timer, 33); // ~30 FPS
-    
-    // Generate initial frame
-    generate_frame(app->state);
     
     return app;
 }
@@ -283,6 +3666,17 @@ void flipper_gen_app_free(FlipperGenApp* app) {
     furi_timer_stop(app->timer);
     furi_timer_free(app->timer);
 
+    if(!session_save(app->state)) {
+        FURI_LOG_W(TAG, "could not save the last frame");
+    }
+    if(checkpoint_sim_size(app->state->active_mode) && !checkpoint_save_now(app->state)) {
+        FURI_LOG_W(TAG, "could not save the checkpoint");
+    }
+    checkpoint_abort(&app->state->checkpoint);
+    if(app->state->active_mode == GenModeImage) {
+        image_close(&app->state->sim.image);
+    }
+
     gui_remove_view_port(app->gui, app->view_port);
     view_port_free(app->view_port);
     furi_message_queue_free(app->event_queue);
@@ -301,37 +3695,69 @@ int32_t flipper_gen_app(void* p) {
     
     notification_message(app->notifications, &sequence_display_backlight_on);
     
+    // Show the restored (or blank) frame, then do the slower setup
     view_port_update(app->view_port);
+    if(response_lut_load(app->state)) {
+        FURI_LOG_I(TAG, "loaded LCD calibration");
+    }
+    // Simulations and tone tables are built on the first tick
+    furi_timer_start(app->timer, 33); // ~30 FPS
 
     // Main event loop
     InputEvent event;
     while(app->running) {
         if(furi_message_queue_get(app->event_queue, &event, 100) == FuriStatusOk) {
-            if(event.type == InputTypePress) {
+            if(event.type == InputTypeLong && event.key == InputKeyOk) {
+                // Cycle modes; the timer thread re-initialises on its next tick
+                app->state->mode = (app->state->mode + 1) % GenModeCount;
+            } else if(event.type == InputTypeLong && event.key == InputKeyRight) {
+                app->state->half_res_smooth = !app->state->half_res_smooth;
+            } else if(event.type == InputTypeLong && event.key == InputKeyLeft) {
+                app->state->filter = (app->state->filter + 1) % FilterCount;
+            } else if(event.type == InputTypeLong && event.key == InputKeyUp) {
+                app->state->morph = (app->state->morph + 1) % MorphCount;
+            } else if(event.type == InputTypeLong && event.key == InputKeyDown) {
+                app->state->auto_levels = !app->state->auto_levels;
+            } else if(
+                event.type == InputTypeShort && event.key == InputKeyOk &&
+                app->state->mode == GenModeCalibrate) {
+                calibration_accept(app->state);
+            } else if(event.type == InputTypeShort && event.key == InputKeyOk) {
+                // Gradient mode rebuilds its parameter curves from the new seed
+                app->state->seed = furi_get_tick();
+                if(app->state->mode != GenModeGradient) {
+                    app->state->reset_requested = true;
+                }
+            } else if(event.type == InputTypeShort) {
+                // Short, not Press: a Press also precedes every Long event
                 switch(event.key) {
-                    case InputKeyOk:
-                        app->state->seed = furi_get_tick();
-                        app->state->gradient_type = app->state->seed % 10;
-                        app->state->frequency = 0.5f + (float)(app->state->seed % 100) / 50.0f;
-                        break;
                     case InputKeyUp:
-                        app->state->gradient_type = (app->state->gradient_type + 1) % 10;
+                        mode_adjust(app->state, true);
                         break;
                     case InputKeyDown:
-                        app->state->gradient_type = (app->state->gradient_type + 9) % 10;
-                        break;
-                    case InputKeyLeft:
-                        app->state->frequency = fmaxf(0.1f, app->state->frequency - 0.1f);
+                        mode_adjust(app->state, false);
                         break;
                     case InputKeyRight:
-                        app->state->frequency = fminf(4.0f, app->state->frequency + 0.1f);
+                        if(app->state->mode == GenModeGradient) {
+                            app->state->curves.frequency_bias =
+                                fminf(2.0f, app->state->curves.frequency_bias + 0.1f);
+                        } else {
+                            app->state->frequency = fminf(4.0f, app->state->frequency + 0.1f);
+                        }
                         break;
-                    case InputKeyBack:
-                        app->running = false;
+                    case InputKeyLeft:
+                        if(app->state->mode == GenModeGradient) {
+                            app->state->curves.frequency_bias =
+                                fmaxf(-2.0f, app->state->curves.frequency_bias - 0.1f);
+                        } else {
+                            app->state->frequency = fmaxf(0.1f, app->state->frequency - 0.1f);
+                        }
                         break;
                     default:
                         break;
                 }
+            } else if(event.type == InputTypePress && event.key == InputKeyBack) {
+                app->running = false;
             }
         }
     }
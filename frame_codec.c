@@ -0,0 +1,270 @@
+#include "frame_codec.h"
+
+#include <string.h>
+
+#define FRAME_ROW_WORDS 4
+#define TILE_COUNT 32 // 4 across, 8 down
+#define TILE_WORDS 8
+#define XOR_BITMAP_BYTES (FRAME_CODEC_WORDS / 8)
+
+#define RUN_ZERO 0x00
+#define RUN_ONES 0x40
+#define RUN_LITERAL 0x80
+#define RUN_REPEAT 0xC0
+#define RUN_MAX 64
+
+const char* const frame_codec_method_names[FrameCodecMethodCount] = {
+    "raw", "xor", "rle", "xor+rle", "tile"};
+
+static inline void put_word(uint8_t* out, uint32_t w) {
+    out[0] = w;
+    out[1] = w >> 8;
+    out[2] = w >> 16;
+    out[3] = w >> 24;
+}
+
+static inline uint32_t get_word(const uint8_t* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// Tile of frame word i: rows of 8 words, tiles numbered across then down
+static inline uint32_t tile_of(uint32_t i) {
+    return ((i >> 5) << 2) | (i & 3);
+}
+
+static inline uint32_t tile_word(uint32_t tile, uint32_t row) {
+    return (((tile >> 2) * TILE_WORDS) + row) * FRAME_ROW_WORDS + (tile & 3);
+}
+
+static inline uint32_t word_at(const uint32_t* frame, const uint32_t* prev, uint32_t i) {
+    return prev ? frame[i] ^ prev[i] : frame[i];
+}
+
+// Word runs of frame (XOR prev, if given). Writes to out unless it is NULL
+// and returns the size either way, so estimates and encodes always agree.
+static size_t rle_runs(const uint32_t* frame, const uint32_t* prev, uint8_t* out) {
+    size_t size = 0;
+    uint32_t i = 0;
+    while(i < FRAME_CODEC_WORDS) {
+        uint32_t w = word_at(frame, prev, i);
+        uint32_t n = 1;
+        while(i + n < FRAME_CODEC_WORDS && n < RUN_MAX && word_at(frame, prev, i + n) == w) {
+            n++;
+        }
+
+        if(w == 0 || w == ~0u) {
+            if(out) out[size] = (w ? RUN_ONES : RUN_ZERO) | (n - 1);
+            size += 1;
+        } else if(n > 1) {
+            if(out) {
+                out[size] = RUN_REPEAT | (n - 1);
+                put_word(out + size + 1, w);
+            }
+            size += 5;
+        } else {
+            // Literals up to the next word that is 0, all ones or starts a repeat
+            while(i + n < FRAME_CODEC_WORDS && n < RUN_MAX) {
+                uint32_t v = word_at(frame, prev, i + n);
+                if(v == 0 || v == ~0u) break;
+                if(i + n + 1 < FRAME_CODEC_WORDS && word_at(frame, prev, i + n + 1) == v) break;
+                n++;
+            }
+            if(out) {
+                out[size] = RUN_LITERAL | (n - 1);
+                for(uint32_t k = 0; k < n; k++) {
+                    put_word(out + size + 1 + k * 4, word_at(frame, prev, i + k));
+                }
+            }
+            size += 1 + n * 4;
+        }
+        i += n;
+    }
+    return size;
+}
+
+void frame_codec_estimate(const uint32_t* frame, const uint32_t* prev, size_t* sizes) {
+    sizes[FrameCodecRaw] = 1 + FRAME_CODEC_BYTES;
+    sizes[FrameCodecRle] = 1 + rle_runs(frame, NULL, NULL);
+    if(!prev) {
+        sizes[FrameCodecXor] = SIZE_MAX;
+        sizes[FrameCodecXorRle] = SIZE_MAX;
+        sizes[FrameCodecTile] = SIZE_MAX;
+        return;
+    }
+
+    uint32_t changed = 0;
+    uint32_t tiles = 0;
+    for(uint32_t i = 0; i < FRAME_CODEC_WORDS; i++) {
+        if(frame[i] != prev[i]) {
+            changed++;
+            tiles |= 1u << tile_of(i);
+        }
+    }
+    sizes[FrameCodecXor] = 1 + XOR_BITMAP_BYTES + changed * 4;
+    sizes[FrameCodecXorRle] = 1 + rle_runs(frame, prev, NULL);
+    sizes[FrameCodecTile] = 1 + 4 + __builtin_popcount(tiles) * TILE_WORDS * 4;
+}
+
+size_t frame_codec_encode_method(
+    FrameCodecMethod method,
+    const uint32_t* frame,
+    const uint32_t* prev,
+    uint8_t* out) {
+    if(!prev && (method == FrameCodecXor || method == FrameCodecXorRle || method == FrameCodecTile)) {
+        return 0;
+    }
+
+    out[0] = method;
+    uint8_t* p = out + 1;
+    switch(method) {
+        case FrameCodecXor: {
+            uint8_t* bitmap = p;
+            memset(bitmap, 0, XOR_BITMAP_BYTES);
+            p += XOR_BITMAP_BYTES;
+            for(uint32_t i = 0; i < FRAME_CODEC_WORDS; i++) {
+                uint32_t x = frame[i] ^ prev[i];
+                if(x) {
+                    bitmap[i >> 3] |= 1 << (i & 7);
+                    put_word(p, x);
+                    p += 4;
+                }
+            }
+            break;
+        }
+        case FrameCodecRle:
+            p += rle_runs(frame, NULL, p);
+            break;
+        case FrameCodecXorRle:
+            p += rle_runs(frame, prev, p);
+            break;
+        case FrameCodecTile: {
+            uint32_t tiles = 0;
+            for(uint32_t i = 0; i < FRAME_CODEC_WORDS; i++) {
+                if(frame[i] != prev[i]) tiles |= 1u << tile_of(i);
+            }
+            put_word(p, tiles);
+            p += 4;
+            for(uint32_t t = 0; t < TILE_COUNT; t++) {
+                if(!(tiles & (1u << t))) continue;
+                for(uint32_t r = 0; r < TILE_WORDS; r++) {
+                    put_word(p, frame[tile_word(t, r)]);
+                    p += 4;
+                }
+            }
+            break;
+        }
+        default:
+            out[0] = FrameCodecRaw;
+            for(uint32_t i = 0; i < FRAME_CODEC_WORDS; i++) {
+                put_word(p, frame[i]);
+                p += 4;
+            }
+            break;
+    }
+    return p - out;
+}
+
+size_t frame_codec_encode(
+    const uint32_t* frame,
+    const uint32_t* prev,
+    uint8_t* out,
+    FrameCodecMethod* method) {
+    size_t sizes[FrameCodecMethodCount];
+    frame_codec_estimate(frame, prev, sizes);
+    // Ties go to the earlier, cheaper to decode, method
+    FrameCodecMethod best = FrameCodecRaw;
+    for(int m = 1; m < FrameCodecMethodCount; m++) {
+        if(sizes[m] < sizes[best]) best = m;
+    }
+    if(method) *method = best;
+    return frame_codec_encode_method(best, frame, prev, out);
+}
+
+static bool runs_decode(const uint8_t* p, const uint8_t* end, uint32_t* frame, bool delta) {
+    uint32_t i = 0;
+    while(p < end) {
+        uint8_t control = *p++;
+        uint32_t n = (control & (RUN_MAX - 1)) + 1;
+        if(i + n > FRAME_CODEC_WORDS) return false;
+        uint32_t* dst = frame + i;
+        switch(control & RUN_REPEAT) {
+            case RUN_ZERO:
+                // A zero delta leaves the words as they are
+                if(!delta) memset(dst, 0, n * sizeof(uint32_t));
+                break;
+            case RUN_ONES:
+                for(uint32_t k = 0; k < n; k++) {
+                    dst[k] = delta ? ~dst[k] : ~0u;
+                }
+                break;
+            case RUN_LITERAL:
+                if((size_t)(end - p) < n * 4) return false;
+                for(uint32_t k = 0; k < n; k++, p += 4) {
+                    dst[k] = delta ? dst[k] ^ get_word(p) : get_word(p);
+                }
+                break;
+            default: {
+                if(end - p < 4) return false;
+                uint32_t w = get_word(p);
+                p += 4;
+                for(uint32_t k = 0; k < n; k++) {
+                    dst[k] = delta ? dst[k] ^ w : w;
+                }
+                break;
+            }
+        }
+        i += n;
+    }
+    return i == FRAME_CODEC_WORDS;
+}
+
+bool frame_codec_decode(const uint8_t* in, size_t size, uint32_t* frame) {
+    if(size < 1) return false;
+    const uint8_t* p = in + 1;
+    const uint8_t* end = in + size;
+
+    switch(in[0]) {
+        case FrameCodecRaw:
+            if(size != 1 + FRAME_CODEC_BYTES) return false;
+            for(uint32_t i = 0; i < FRAME_CODEC_WORDS; i++, p += 4) {
+                frame[i] = get_word(p);
+            }
+            return true;
+        case FrameCodecXor: {
+            if(end - p < XOR_BITMAP_BYTES) return false;
+            const uint8_t* bitmap = p;
+            p += XOR_BITMAP_BYTES;
+            // Walk the set bits a bitmap word at a time
+            for(uint32_t base = 0; base < FRAME_CODEC_WORDS; base += 32) {
+                uint32_t bits = get_word(bitmap + base / 8);
+                while(bits) {
+                    if(end - p < 4) return false;
+                    frame[base + __builtin_ctz(bits)] ^= get_word(p);
+                    p += 4;
+                    bits &= bits - 1;
+                }
+            }
+            return p == end;
+        }
+        case FrameCodecRle:
+            return runs_decode(p, end, frame, false);
+        case FrameCodecXorRle:
+            return runs_decode(p, end, frame, true);
+        case FrameCodecTile: {
+            if(end - p < 4) return false;
+            uint32_t tiles = get_word(p);
+            p += 4;
+            if((size_t)(end - p) != (size_t)__builtin_popcount(tiles) * TILE_WORDS * 4) return false;
+            while(tiles) {
+                uint32_t t = __builtin_ctz(tiles);
+                for(uint32_t r = 0; r < TILE_WORDS; r++, p += 4) {
+                    frame[tile_word(t, r)] = get_word(p);
+                }
+                tiles &= tiles - 1;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
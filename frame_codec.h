@@ -0,0 +1,71 @@
+// Frame codec for packed 128x64 1bpp frames (the app's fb layout: 64 rows of
+// 4 words, LSB = leftmost pixel). Plain C with no firmware dependencies, so
+// the same code runs on the Flipper and in tools/codec_bench.c.
+//
+// An encoded frame is one method byte followed by its payload:
+//
+//   Raw       the 256 frame words
+//   Xor       32-byte bitmap of words that differ from the previous frame,
+//             then those words XORed with the previous frame
+//   Rle       word runs of the frame (see below)
+//   XorRle    word runs of the frame XOR the previous frame
+//   Tile      4-byte bitmap of changed 32x8 tiles (one word wide, 8 rows),
+//             then the new 8 words of each changed tile
+//
+// Word runs are control bytes, with n = (control & 63) + 1 words:
+//
+//   00nnnnnn  n zero words
+//   01nnnnnn  n all-ones words
+//   10nnnnnn  n literal words follow
+//   11nnnnnn  the following word, repeated n times
+//
+// Words are stored little-endian. Xor, XorRle and Tile are deltas: the
+// decoder updates the previous frame in place.
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRAME_CODEC_WORDS 256
+#define FRAME_CODEC_BYTES (FRAME_CODEC_WORDS * 4)
+// Worst case over all methods (Xor with every word changed); frame_codec_encode
+// itself never writes more than a raw frame, 1 + FRAME_CODEC_BYTES
+#define FRAME_CODEC_MAX_SIZE (1 + FRAME_CODEC_WORDS / 8 + FRAME_CODEC_BYTES)
+
+typedef enum {
+    FrameCodecRaw,
+    FrameCodecXor,
+    FrameCodecRle,
+    FrameCodecXorRle,
+    FrameCodecTile,
+    FrameCodecMethodCount,
+} FrameCodecMethod;
+
+extern const char* const frame_codec_method_names[FrameCodecMethodCount];
+
+// Exact encoded size of every method, counted without writing anything.
+// prev may be NULL (no previous frame): the delta methods then report
+// SIZE_MAX.
+void frame_codec_estimate(const uint32_t* frame, const uint32_t* prev, size_t* sizes);
+
+// Encode with a given method; out must hold FRAME_CODEC_MAX_SIZE bytes.
+// Returns the encoded size, or 0 for a delta method without prev.
+size_t frame_codec_encode_method(
+    FrameCodecMethod method,
+    const uint32_t* frame,
+    const uint32_t* prev,
+    uint8_t* out);
+
+// Encode with the smallest method for this frame; out must hold
+// 1 + FRAME_CODEC_BYTES bytes. The method used is stored in *method if set.
+size_t frame_codec_encode(
+    const uint32_t* frame,
+    const uint32_t* prev,
+    uint8_t* out,
+    FrameCodecMethod* method);
+
+// Decode into frame, which must hold the previous frame for delta methods.
+// Returns false on a truncated or malformed stream; frame may then be
+// partially updated.
+bool frame_codec_decode(const uint8_t* in, size_t size, uint32_t* frame);
@@ -0,0 +1,97 @@
+#include "gradient.h"
+
+#include <math.h>
+
+#include "lut_tables.h"
+
+// 64 steps per turn, so angle + 16 is the cosine
+static int8_t fast_sin(uint8_t angle) {
+    return sine_table[angle & 63];
+}
+
+uint8_t gradient_eval(
+    const GradientParams* params,
+    const uint8_t* tone_lut,
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h) {
+    float nx = (float)x / w;
+    float ny = (float)y / h;
+    float value = 0.0f;
+    
+    switch(params->gradient_type) {
+        case 0: // horizontal
+            value = nx;
+            break;
+        case 1: // vertical
+            value = ny;
+            break;
+        case 2: // radial
+            {
+                float dx = nx - 0.5f;
+                float dy = ny - 0.5f;
+                value = sqrtf(dx*dx + dy*dy) * 1.414f; // normalize
+            }
+            break;
+        case 3: // diagonal
+            value = (nx + ny) / 2.0f;
+            break;
+        case 4: // sine wave
+            value = (fast_sin((uint8_t)(nx * 64 * params->frequency)) + 64) / 128.0f;
+            break;
+        case 5: // cosine wave
+            value = (fast_sin((uint8_t)(ny * 64 * params->frequency + 16)) + 64) / 128.0f;
+            break;
+        case 6: // interference
+            {
+                int8_t wave1 = fast_sin((uint8_t)(nx * 32 * params->frequency));
+                int8_t wave2 = fast_sin((uint8_t)(ny * 32 * params->frequency));
+                value = ((wave1 * wave2) / 64 + 64) / 128.0f;
+            }
+            break;
+        case 7: // checkerboard
+            {
+                uint8_t check_x = (uint8_t)(nx * 8 * params->frequency) & 1;
+                uint8_t check_y = (uint8_t)(ny * 8 * params->frequency) & 1;
+                value = (check_x ^ check_y) ? 1.0f : 0.0f;
+            }
+            break;
+        case 8: // noise
+            value = simple_noise(x, y, params->seed) / 255.0f;
+            break;
+        case 9: // spiral
+            {
+                float dx = nx - 0.5f;
+                float dy = ny - 0.5f;
+                float angle = atan2f(dy, dx);
+                float dist = sqrtf(dx*dx + dy*dy);
+                value = fmodf((angle + dist * 10.0f), 6.28f) / 6.28f;
+            }
+            break;
+        default:
+            value = nx;
+    }
+    
+    // 8.8 fixed point, signed: spiral dips below 0 near its centre, so
+    // clamp only after the blend, as the float path did
+    int32_t level = (int32_t)(value * (255 * 256));
+    
+    // Apply noise overlay as a 70/30 integer blend
+    if(params->noise_scale > 0) {
+        int32_t noise = simple_noise(
+            (uint32_t)(x * params->noise_scale),
+            (uint32_t)(y * params->noise_scale),
+            params->seed
+        );
+        level = (level * 179 + (noise << 8) * 77) >> 8;
+    }
+    level >>= 8;
+    if(level < 0) level = 0;
+    if(level > 255) level = 255;
+    
+    if(params->histogram) params->histogram[level]++;
+
+    // Levels, gamma, contrast, brightness and invert in one lookup
+    return tone_lut[level];
+}
@@ -0,0 +1,32 @@
+// Gradient patterns: one 8-bit level per pixel from a pattern type, an
+// optional noise overlay and a tone LUT. Plain C with no firmware
+// dependencies, so the same code runs on the Flipper and in
+// tools/gradient_parity.c.
+#pragma once
+
+#include <stdint.h>
+
+// Everything a gradient needs besides the tone LUT
+typedef struct {
+    uint8_t gradient_type;
+    float frequency;
+    float noise_scale;
+    uint32_t seed;
+    uint16_t* histogram; // optional, counts levels before the tone LUT
+} GradientParams;
+
+// Simple Perlin-like noise using bit manipulation
+static inline uint8_t simple_noise(uint32_t x, uint32_t y, uint32_t seed) {
+    uint32_t hash = (x * 374761393) + (y * 668265263) + seed;
+    hash = (hash ^ (hash >> 13)) * 1274126177;
+    return (hash ^ (hash >> 16)) & 0xFF;
+}
+
+// Level at (x, y) of a w x h region, passed through tone_lut
+uint8_t gradient_eval(
+    const GradientParams* params,
+    const uint8_t* tone_lut,
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h);
@@ -0,0 +1,63 @@
+// Generated by tools/gen_luts.py -- do not edit, rerun the script instead
+#pragma once
+
+#include <stdint.h>
+
+#define SINE_TABLE_CRC32 0x0BB8F445u
+#define BAYER8_CRC32 0x98E66109u
+#define RECIPROCAL_TABLE_CRC32 0xF91C26ACu
+#define EVOLVE_FADE_CRC32 0xC311CA87u
+
+// Sine, 64 steps per turn, amplitude 64
+static const int8_t sine_table[64] = {
+    0, 6, 12, 19, 24, 30, 36, 41, 45, 49, 53, 56, 59, 61, 63, 64,
+    64, 64, 63, 61, 59, 56, 53, 49, 45, 41, 36, 30, 24, 19, 12, 6,
+    0, -6, -12, -19, -24, -30, -36, -41, -45, -49, -53, -56, -59, -61, -63, -64,
+    -64, -64, -63, -61, -59, -56, -53, -49, -45, -41, -36, -30, -24, -19, -12, -6,
+};
+
+// 8x8 Bayer matrix scaled to 0..255 thresholds
+static const uint8_t bayer8[8][8] = {
+    {2, 130, 34, 162, 10, 138, 42, 170},
+    {194, 66, 226, 98, 202, 74, 234, 106},
+    {50, 178, 18, 146, 58, 186, 26, 154},
+    {242, 114, 210, 82, 250, 122, 218, 90},
+    {14, 142, 46, 174, 6, 134, 38, 166},
+    {206, 78, 238, 110, 198, 70, 230, 102},
+    {62, 190, 30, 158, 54, 182, 22, 150},
+    {254, 126, 222, 94, 246, 118, 214, 86},
+};
+
+// Perspective divide becomes a multiply: reciprocal_table[z] = 65536 / z
+static const uint16_t reciprocal_table[256] = {
+    65535, 65535, 32768, 21845, 16384, 13107, 10922, 9362, 8192, 7281, 6553, 5957,
+    5461, 5041, 4681, 4369, 4096, 3855, 3640, 3449, 3276, 3120, 2978, 2849,
+    2730, 2621, 2520, 2427, 2340, 2259, 2184, 2114, 2048, 1985, 1927, 1872,
+    1820, 1771, 1724, 1680, 1638, 1598, 1560, 1524, 1489, 1456, 1424, 1394,
+    1365, 1337, 1310, 1285, 1260, 1236, 1213, 1191, 1170, 1149, 1129, 1110,
+    1092, 1074, 1057, 1040, 1024, 1008, 992, 978, 963, 949, 936, 923,
+    910, 897, 885, 873, 862, 851, 840, 829, 819, 809, 799, 789,
+    780, 771, 762, 753, 744, 736, 728, 720, 712, 704, 697, 689,
+    682, 675, 668, 661, 655, 648, 642, 636, 630, 624, 618, 612,
+    606, 601, 595, 590, 585, 579, 574, 569, 564, 560, 555, 550,
+    546, 541, 537, 532, 528, 524, 520, 516, 512, 508, 504, 500,
+    496, 492, 489, 485, 481, 478, 474, 471, 468, 464, 461, 458,
+    455, 451, 448, 445, 442, 439, 436, 434, 431, 428, 425, 422,
+    420, 417, 414, 412, 409, 407, 404, 402, 399, 397, 394, 392,
+    390, 387, 385, 383, 381, 378, 376, 374, 372, 370, 368, 366,
+    364, 362, 360, 358, 356, 354, 352, 350, 348, 346, 344, 343,
+    341, 339, 337, 336, 334, 332, 330, 329, 327, 326, 324, 322,
+    321, 319, 318, 316, 315, 313, 312, 310, 309, 307, 306, 304,
+    303, 302, 300, 299, 297, 296, 295, 293, 292, 291, 289, 288,
+    287, 286, 284, 283, 282, 281, 280, 278, 277, 276, 275, 274,
+    273, 271, 270, 269, 268, 267, 266, 265, 264, 263, 262, 261,
+    260, 259, 258, 257,
+};
+
+// Smoothstep over one knot span, 0..255
+static const uint8_t evolve_fade[64] = {
+    0, 0, 1, 2, 3, 4, 6, 8, 11, 14, 17, 20, 24, 27, 31, 35,
+    40, 44, 49, 54, 59, 64, 70, 75, 81, 86, 92, 98, 104, 110, 116, 122,
+    128, 133, 139, 145, 151, 157, 163, 169, 174, 180, 185, 191, 196, 201, 206, 211,
+    215, 220, 224, 228, 231, 235, 238, 241, 244, 247, 249, 251, 252, 253, 254, 255,
+};
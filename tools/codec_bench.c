@@ -0,0 +1,241 @@
+// Host benchmark for frame_codec: encodes sequences of synthetic frames
+// that behave like the app's modes, checks every frame round-trips, and
+// reports the size of each method, the adaptive choice, and encode/decode
+// throughput in MB/s of raw frame data. From the repository root:
+//
+//     cc -O2 -I. -o codec_bench tools/codec_bench.c frame_codec.c
+//     ./codec_bench
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "frame_codec.h"
+#include "lut_tables.h"
+
+#define W 128
+#define H 64
+#define FRAMES 300
+#define REPS 20
+
+typedef uint32_t Frame[FRAME_CODEC_WORDS];
+
+static uint32_t rng = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static void set_pixel(uint32_t* f, int x, int y) {
+    if(x < 0 || y < 0 || x >= W || y >= H) return;
+    f[y * 4 + (x >> 5)] |= 1u << (x & 31);
+}
+
+static void draw_line(uint32_t* f, int x0, int y0, int x1, int y1) {
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for(;;) {
+        set_pixel(f, x0, y0);
+        if(x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if(e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if(e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+// Drifting interference field, ordered dither: most words change every frame
+static void gen_gradient(Frame* frames) {
+    for(int t = 0; t < FRAMES; t++) {
+        memset(frames[t], 0, sizeof(Frame));
+        for(int y = 0; y < H; y++) {
+            for(int x = 0; x < W; x++) {
+                int v = 128 + sine_table[(x / 2 + t) & 63] + sine_table[(y + x / 4 + t / 2) & 63];
+                if(v > bayer8[y & 7][x & 7]) set_pixel(frames[t], x, y);
+            }
+        }
+    }
+}
+
+// Same picture every frame
+static void gen_static(Frame* frames) {
+    gen_gradient(frames);
+    for(int t = 1; t < FRAMES; t++) {
+        memcpy(frames[t], frames[0], sizeof(Frame));
+    }
+}
+
+// Falling grains on an empty screen: sparse scattered changes
+static void gen_sand(Frame* frames) {
+    int gx[400], gy[400];
+    for(int i = 0; i < 400; i++) {
+        gx[i] = xorshift32() % W;
+        gy[i] = xorshift32() % H;
+    }
+    for(int t = 0; t < FRAMES; t++) {
+        memset(frames[t], 0, sizeof(Frame));
+        for(int i = 0; i < 400; i++) {
+            if(++gy[i] >= H) {
+                gy[i] = 0;
+                gx[i] = xorshift32() % W;
+            }
+            set_pixel(frames[t], gx[i], gy[i]);
+        }
+    }
+}
+
+// Rotating square with its diagonals, redrawn on a cleared frame
+static void gen_wireframe(Frame* frames) {
+    for(int t = 0; t < FRAMES; t++) {
+        memset(frames[t], 0, sizeof(Frame));
+        int px[4], py[4];
+        for(int k = 0; k < 4; k++) {
+            uint8_t a = t / 2 + k * 16;
+            px[k] = W / 2 + sine_table[(a + 16) & 63] * 28 / 64;
+            py[k] = H / 2 + sine_table[a & 63] * 28 / 64;
+        }
+        for(int k = 0; k < 4; k++) {
+            draw_line(frames[t], px[k], py[k], px[(k + 1) & 3], py[(k + 1) & 3]);
+        }
+        draw_line(frames[t], px[0], py[0], px[2], py[2]);
+        draw_line(frames[t], px[1], py[1], px[3], py[3]);
+    }
+}
+
+// 8x8 diagonal tiles, a few flipped per frame
+static void gen_tiles(Frame* frames) {
+    uint8_t flip[H / 8][W / 8];
+    for(int y = 0; y < H / 8; y++) {
+        for(int x = 0; x < W / 8; x++) {
+            flip[y][x] = xorshift32() & 1;
+        }
+    }
+    for(int t = 0; t < FRAMES; t++) {
+        for(int k = 0; k < 3; k++) {
+            flip[xorshift32() % (H / 8)][xorshift32() % (W / 8)] ^= 1;
+        }
+        memset(frames[t], 0, sizeof(Frame));
+        for(int y = 0; y < H; y++) {
+            for(int x = 0; x < W; x++) {
+                int d = flip[y / 8][x / 8] ? (x & 7) - (y & 7) : (x & 7) + (y & 7) - 7;
+                if(d == 0) set_pixel(frames[t], x, y);
+            }
+        }
+    }
+}
+
+// Incompressible
+static void gen_noise(Frame* frames) {
+    for(int t = 0; t < FRAMES; t++) {
+        for(int i = 0; i < FRAME_CODEC_WORDS; i++) {
+            frames[t][i] = xorshift32();
+        }
+    }
+}
+
+static const struct {
+    const char* name;
+    void (*generate)(Frame* frames);
+} patterns[] = {
+    {"static", gen_static},
+    {"gradient", gen_gradient},
+    {"sand", gen_sand},
+    {"wireframe", gen_wireframe},
+    {"tiles", gen_tiles},
+    {"noise", gen_noise},
+};
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    static Frame frames[FRAMES];
+    static uint8_t stream[FRAMES][1 + FRAME_CODEC_BYTES];
+    static size_t sizes[FRAMES];
+    static uint8_t scratch[FRAME_CODEC_MAX_SIZE];
+    int failed = 0;
+
+    printf("%-10s", "pattern");
+    for(int m = 0; m < FrameCodecMethodCount; m++) {
+        printf(" %8s", frame_codec_method_names[m]);
+    }
+    printf(" %8s %6s %9s %9s  methods chosen\n", "best", "ratio", "enc MB/s", "dec MB/s");
+
+    for(size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        patterns[p].generate(frames);
+
+        // Fixed methods, bytes per frame; the first frame of a delta method
+        // has no reference and is sent raw
+        size_t fixed[FrameCodecMethodCount] = {0};
+        for(int t = 0; t < FRAMES; t++) {
+            for(int m = 0; m < FrameCodecMethodCount; m++) {
+                size_t n = frame_codec_encode_method(m, frames[t], t ? frames[t - 1] : NULL, scratch);
+                fixed[m] += n ? n : 1 + FRAME_CODEC_BYTES;
+            }
+        }
+
+        uint32_t chosen[FrameCodecMethodCount] = {0};
+        size_t total = 0;
+        double start = now_s();
+        for(int r = 0; r < REPS; r++) {
+            total = 0;
+            for(int t = 0; t < FRAMES; t++) {
+                FrameCodecMethod method;
+                sizes[t] = frame_codec_encode(frames[t], t ? frames[t - 1] : NULL, stream[t], &method);
+                total += sizes[t];
+                if(r == 0) chosen[method]++;
+            }
+        }
+        double enc_s = now_s() - start;
+
+        Frame out;
+        start = now_s();
+        for(int r = 0; r < REPS; r++) {
+            for(int t = 0; t < FRAMES; t++) {
+                if(!frame_codec_decode(stream[t], sizes[t], out)) failed++;
+            }
+        }
+        double dec_s = now_s() - start;
+
+        // Round trip, checked outside the timed loop
+        memset(out, 0, sizeof(out));
+        for(int t = 0; t < FRAMES; t++) {
+            if(!frame_codec_decode(stream[t], sizes[t], out) ||
+               memcmp(out, frames[t], sizeof(Frame)) != 0) {
+                printf("%s: frame %d does not round-trip\n", patterns[p].name, t);
+                failed++;
+                break;
+            }
+        }
+
+        double mb = (double)FRAMES * REPS * FRAME_CODEC_BYTES / 1e6;
+        printf("%-10s", patterns[p].name);
+        for(int m = 0; m < FrameCodecMethodCount; m++) {
+            printf(" %8.1f", (double)fixed[m] / FRAMES);
+        }
+        printf(
+            " %8.1f %5.1fx %9.0f %9.0f ",
+            (double)total / FRAMES,
+            (double)FRAMES * FRAME_CODEC_BYTES / total,
+            mb / enc_s,
+            mb / dec_s);
+        for(int m = 0; m < FrameCodecMethodCount; m++) {
+            if(chosen[m]) printf(" %s:%lu", frame_codec_method_names[m], (unsigned long)chosen[m]);
+        }
+        printf("\n");
+    }
+    printf("(sizes are mean bytes per %d-byte frame)\n", FRAME_CODEC_BYTES);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Generate lut_tables.h, the app's constant lookup tables.
+
+The tables are computed here once instead of at startup on the Flipper, and
+land in .rodata as const arrays. Run after changing a table:
+
+    python3 tools/gen_luts.py            # rewrite lut_tables.h
+    python3 tools/gen_luts.py --check    # verify it is up to date
+
+--check regenerates the header in memory, compares it with the committed
+file and recomputes the per-table CRC32s; it exits non-zero on any mismatch.
+"""
+
+import math
+import os
+import re
+import sys
+import zlib
+
+HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "lut_tables.h")
+
+
+def sine_table():
+    # 64 steps per turn, amplitude 64: angle + 16 is the cosine
+    return [round(64 * math.sin(2 * math.pi * i / 64)) for i in range(64)]
+
+
+def bayer8():
+    # Recursive Bayer index matrix, scaled to 0..255 thresholds
+    m = [[0]]
+    while len(m) < 8:
+        n = len(m)
+        m = [
+            [4 * m[y % n][x % n] + [[0, 2], [3, 1]][y // n][x // n] for x in range(2 * n)]
+            for y in range(2 * n)
+        ]
+    return [[v * 4 + 2 for v in row] for row in m]
+
+
+def reciprocal_table():
+    # 65536 / z, saturated; z = 0 maps to the largest value
+    return [0xFFFF] + [min(0xFFFF, 65536 // z) for z in range(1, 256)]
+
+
+def evolve_fade():
+    # Smoothstep over one 64-frame knot span, 0..255
+    return [round(255 * (i / 64) ** 2 * (3 - 2 * i / 64)) for i in range(64)]
+
+
+# name, C type, element size in bytes, signed, data, comment
+TABLES = [
+    ("sine_table", "int8_t", 1, True, sine_table(), "Sine, 64 steps per turn, amplitude 64"),
+    ("bayer8", "uint8_t", 1, False, bayer8(), "8x8 Bayer matrix scaled to 0..255 thresholds"),
+    (
+        "reciprocal_table",
+        "uint16_t",
+        2,
+        False,
+        reciprocal_table(),
+        "Perspective divide becomes a multiply: reciprocal_table[z] = 65536 / z",
+    ),
+    ("evolve_fade", "uint8_t", 1, False, evolve_fade(), "Smoothstep over one knot span, 0..255"),
+]
+
+
+def flatten(data):
+    return [v for row in data for v in row] if isinstance(data[0], list) else data
+
+
+def crc32(size, signed, values):
+    blob = b"".join(v.to_bytes(size, "little", signed=signed) for v in values)
+    return zlib.crc32(blob) & 0xFFFFFFFF
+
+
+def emit_array(name, ctype, size, data, comment):
+    lines = ["// " + comment]
+    if isinstance(data[0], list):
+        lines.append("static const %s %s[%d][%d] = {" % (ctype, name, len(data), len(data[0])))
+        for row in data:
+            lines.append("    {" + ", ".join(str(v) for v in row) + "},")
+    else:
+        lines.append("static const %s %s[%d] = {" % (ctype, name, len(data)))
+        per_line = 16 if size == 1 else 12
+        for i in range(0, len(data), per_line):
+            lines.append("    " + ", ".join(str(v) for v in data[i : i + per_line]) + ",")
+    lines.append("};")
+    return lines
+
+
+def generate():
+    out = [
+        "// Generated by tools/gen_luts.py -- do not edit, rerun the script instead",
+        "#pragma once",
+        "",
+        "#include <stdint.h>",
+        "",
+    ]
+    for name, ctype, size, signed, data, comment in TABLES:
+        out.append(
+            "#define %s_CRC32 0x%08Xu" % (name.upper(), crc32(size, signed, flatten(data)))
+        )
+    out.append("")
+    for name, ctype, size, signed, data, comment in TABLES:
+        out += emit_array(name, ctype, size, data, comment)
+        out.append("")
+    return "\n".join(out)
+
+
+def parse_values(text, name):
+    body = re.search(r"\b%s(?:\[\d+\])+ = \{(.*?)\n\};" % name, text, re.S)
+    if not body:
+        return None
+    return [int(v) for v in re.findall(r"-?\d+", body.group(1))]
+
+
+def check():
+    expected = generate()
+    try:
+        with open(HEADER) as f:
+            actual = f.read()
+    except OSError as e:
+        print("lut_tables.h: %s" % e)
+        return 1
+
+    ok = actual == expected
+    if not ok:
+        print("lut_tables.h is stale: rerun tools/gen_luts.py")
+    for name, ctype, size, signed, data, comment in TABLES:
+        values = parse_values(actual, name)
+        declared = re.search(r"#define %s_CRC32 (0x[0-9A-F]+)u" % name.upper(), actual)
+        want = crc32(size, signed, flatten(data))
+        got = crc32(size, signed, values) if values else None
+        table_ok = got == want and declared is not None and int(declared.group(1), 16) == want
+        ok = ok and table_ok
+        print(
+            "%-18s %5d bytes  crc32 %08X  %s"
+            % (name, len(flatten(data)) * size, want, "ok" if table_ok else "MISMATCH")
+        )
+    return 0 if ok else 1
+
+
+def main():
+    if "--check" in sys.argv[1:]:
+        return check()
+    with open(HEADER, "w") as f:
+        f.write(generate())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
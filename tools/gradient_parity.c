@@ -0,0 +1,143 @@
+// Host check for gradient.c: compares gradient_eval against the original
+// float pipeline (blend the noise overlay, then clamp) for every pattern
+// type, with and without noise. Spiral runs below 0 near its centre, which
+// catches a clamp applied before the blend. Invert and the other tone
+// adjustments live in the app's tone LUT, so this runs with an identity
+// LUT. Exits non-zero if any pixel is more than 1 level off. From the
+// repository root:
+//
+//     cc -O2 -I. -o gradient_parity tools/gradient_parity.c gradient.c -lm
+//     ./gradient_parity
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gradient.h"
+#include "lut_tables.h"
+
+#define W 128
+#define H 64
+#define TOLERANCE 1
+
+static int8_t fast_sin(uint8_t angle) {
+    return sine_table[angle & 63];
+}
+
+// The app's original per-pixel path, in float throughout
+static uint8_t reference_eval(const GradientParams* params, uint8_t x, uint8_t y) {
+    float nx = (float)x / W;
+    float ny = (float)y / H;
+    float value = 0.0f;
+
+    switch(params->gradient_type) {
+        case 0:
+            value = nx;
+            break;
+        case 1:
+            value = ny;
+            break;
+        case 2: {
+            float dx = nx - 0.5f;
+            float dy = ny - 0.5f;
+            value = sqrtf(dx * dx + dy * dy) * 1.414f;
+        } break;
+        case 3:
+            value = (nx + ny) / 2.0f;
+            break;
+        case 4:
+            value = (fast_sin((uint8_t)(nx * 64 * params->frequency)) + 64) / 128.0f;
+            break;
+        case 5:
+            value = (fast_sin((uint8_t)(ny * 64 * params->frequency + 16)) + 64) / 128.0f;
+            break;
+        case 6: {
+            int8_t wave1 = fast_sin((uint8_t)(nx * 32 * params->frequency));
+            int8_t wave2 = fast_sin((uint8_t)(ny * 32 * params->frequency));
+            value = ((wave1 * wave2) / 64 + 64) / 128.0f;
+        } break;
+        case 7: {
+            uint8_t check_x = (uint8_t)(nx * 8 * params->frequency) & 1;
+            uint8_t check_y = (uint8_t)(ny * 8 * params->frequency) & 1;
+            value = (check_x ^ check_y) ? 1.0f : 0.0f;
+        } break;
+        case 8:
+            value = simple_noise(x, y, params->seed) / 255.0f;
+            break;
+        case 9: {
+            float dx = nx - 0.5f;
+            float dy = ny - 0.5f;
+            float angle = atan2f(dy, dx);
+            float dist = sqrtf(dx * dx + dy * dy);
+            value = fmodf((angle + dist * 10.0f), 6.28f) / 6.28f;
+        } break;
+    }
+
+    if(params->noise_scale > 0) {
+        float noise = simple_noise(
+                          (uint32_t)(x * params->noise_scale),
+                          (uint32_t)(y * params->noise_scale),
+                          params->seed) /
+                      255.0f;
+        value = value * 0.7f + noise * 0.3f;
+    }
+
+    if(value < 0) value = 0;
+    if(value > 1) value = 1;
+    return (uint8_t)(value * 255);
+}
+
+int main(void) {
+    static const float noise_scales[] = {0.0f, 0.03f, 0.1f, 1.0f};
+    static const float frequencies[] = {0.5f, 1.0f, 2.5f};
+    static const uint32_t seeds[] = {1, 0x12345678, 0xDEADBEEF};
+
+    uint8_t identity[256];
+    for(int i = 0; i < 256; i++) {
+        identity[i] = i;
+    }
+
+    int failures = 0;
+    for(int type = 0; type < 10; type++) {
+        int worst = 0;
+        long off = 0;
+        long total = 0;
+        for(size_t n = 0; n < sizeof(noise_scales) / sizeof(noise_scales[0]); n++) {
+            for(size_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+                for(size_t s = 0; s < sizeof(seeds) / sizeof(seeds[0]); s++) {
+                    GradientParams params = {
+                        .gradient_type = type,
+                        .frequency = frequencies[f],
+                        .noise_scale = noise_scales[n],
+                        .seed = seeds[s],
+                        .histogram = NULL,
+                    };
+                    for(int y = 0; y < H; y++) {
+                        for(int x = 0; x < W; x++) {
+                            int got = gradient_eval(&params, identity, x, y, W, H);
+                            int want = reference_eval(&params, x, y);
+                            int diff = abs(got - want);
+                            if(diff > worst) worst = diff;
+                            if(diff > TOLERANCE) off++;
+                            total++;
+                        }
+                    }
+                }
+            }
+        }
+        printf(
+            "type %d: max diff %d, %ld of %ld px off by more than %d\n",
+            type,
+            worst,
+            off,
+            total,
+            TOLERANCE);
+        if(off) failures++;
+    }
+
+    if(failures) {
+        printf("FAIL: %d pattern types differ from the float path\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}